@@ -37,7 +37,8 @@
 ** Platform Deployment Configurations
 */
 
-#define PL_SIM_PLATFORM_REV   0
-#define PL_SIM_INI_FILENAME   "/cf/pl_sim_ini.json"
+#define PL_SIM_PLATFORM_REV        0
+#define PL_SIM_INI_FILENAME        "/cf/pl_sim_ini.json"
+#define PL_SIM_INI_CACHE_FILENAME  "/cf/pl_sim_ini.bin"
 
 #endif /* _pl_sim_platform_cfg_ */
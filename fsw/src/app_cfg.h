@@ -48,15 +48,19 @@
 **
 ** 1.0 - Initial release based on OpenSatKit Instrument Simulator(ISIM)
 ** 3.1 - Compatible with Basecamp 3.x new app version management
+** 3.3 - Deferred event log, load generator, telemetry shaper, image
+**       statistics, configuration cache and reload
 */
 
 #define  PL_SIM_MAJOR_VER   3
-#define  PL_SIM_MINOR_VER   2
+#define  PL_SIM_MINOR_VER   3
 
 
 /******************************************************************************
 ** JSON init file definitions/declarations.
 **    
+** PL_SIM_Config_t and the code that copies the parsed values are generated
+** from APP_CONFIG. Parameter types must be uint32 or char*.
 */
 
 #define CFG_APP_CFE_NAME    APP_CFE_NAME
@@ -64,33 +68,122 @@
 #define CFG_PL_SIM_CMD_TOPICID        PL_SIM_CMD_TOPICID
 #define CFG_BC_SCH_1_HZ_TOPICID       BC_SCH_1_HZ_TOPICID
 #define CFG_PL_SIM_STATUS_TLM_TOPICID PL_SIM_STATUS_TLM_TOPICID
+#define CFG_PL_SIM_LOAD_GEN_TLM_TOPICID PL_SIM_LOAD_GEN_TLM_TOPICID
+#define CFG_PL_SIM_IMAGE_SUMMARY_TLM_TOPICID PL_SIM_IMAGE_SUMMARY_TLM_TOPICID
 #define CFG_TLM_SLOW_RATE             TLM_SLOW_RATE
       
 #define CFG_CMD_PIPE_DEPTH  CMD_PIPE_DEPTH
 #define CFG_CMD_PIPE_NAME   CMD_PIPE_NAME
 
+#define CFG_EVT_LOG_FLUSH_LIM  EVT_LOG_FLUSH_LIM
+
+#define CFG_TLM_SHAPER_STATUS_BYTES_PER_SEC   TLM_SHAPER_STATUS_BYTES_PER_SEC
+#define CFG_TLM_SHAPER_STATUS_BURST_BYTES     TLM_SHAPER_STATUS_BURST_BYTES
+#define CFG_TLM_SHAPER_SCIENCE_BYTES_PER_SEC  TLM_SHAPER_SCIENCE_BYTES_PER_SEC
+#define CFG_TLM_SHAPER_SCIENCE_BURST_BYTES    TLM_SHAPER_SCIENCE_BURST_BYTES
+
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
    XX(PL_SIM_CMD_TOPICID,uint32) \
    XX(BC_SCH_1_HZ_TOPICID,uint32) \
    XX(PL_SIM_STATUS_TLM_TOPICID,uint32) \
+   XX(PL_SIM_LOAD_GEN_TLM_TOPICID,uint32) \
+   XX(PL_SIM_IMAGE_SUMMARY_TLM_TOPICID,uint32) \
    XX(TLM_SLOW_RATE,uint32) \
    XX(CMD_PIPE_DEPTH,uint32) \
    XX(CMD_PIPE_NAME,char*) \
+   XX(EVT_LOG_FLUSH_LIM,uint32) \
+   XX(TLM_SHAPER_STATUS_BYTES_PER_SEC,uint32) \
+   XX(TLM_SHAPER_STATUS_BURST_BYTES,uint32) \
+   XX(TLM_SHAPER_SCIENCE_BYTES_PER_SEC,uint32) \
+   XX(TLM_SHAPER_SCIENCE_BURST_BYTES,uint32) \
 
 DECLARE_ENUM(Config,APP_CONFIG)
 
+/*
+** CMD_PIPE_DEPTH is validated against PL_SIM_CMD_PIPE_DEPTH_MAX which must
+** not exceed CFE_PLATFORM_SB_MAX_PIPE_DEPTH.
+*/
+
+#define PL_SIM_CMD_PIPE_DEPTH_MAX  256
+
 
 /******************************************************************************
 ** Command Macros
 **
+** Command function codes are generated from pl_sim.xml into pl_sim_eds_cc.h
+** and mapped to their functions by the command table in pl_sim_app.c.
+*/
+
+
+/******************************************************************************
+** Event Log
+**
+** EVT_LOG_REC_MAX must be a power of 2 so record indexing remains continuous
+** when the 32-bit record counters roll over.
+*/
+
+#define EVT_LOG_REC_MAX  256
+#define EVT_LOG_ARG_MAX    3
+
+
+/******************************************************************************
+** Load Generator
+**
+** LOAD_GEN_RATE_MAX limits the commands sent per second and
+** LOAD_GEN_BURST_LEN_MAX limits the commands sent back-to-back in one burst.
+** LOAD_GEN_INVALID_CMD_FC must not be registered with the command manager.
+** Execution cycle intervals longer than the nominal period plus the late
+** tolerance are counted as late. The child task priority is higher than
+** the app's priority in pl_sim.json so bursts arrive faster than the app
+** can read them.
+*/
+
+#define LOAD_GEN_RATE_MAX         5000
+#define LOAD_GEN_BURST_LEN_MAX     100
+#define LOAD_GEN_INVALID_CMD_FC   (CMDMGR_APP_START_FC + 20)
+#define LOAD_GEN_TICK_PERIOD_MS   1000
+#define LOAD_GEN_TICK_LATE_MS      100
+
+#define LOAD_GEN_CHILD_NAME        "PL_SIM_LOAD_GEN"
+#define LOAD_GEN_CHILD_STACK_SIZE  8192
+#define LOAD_GEN_CHILD_PRIORITY    60
+#define LOAD_GEN_CHILD_PERIOD_MS   10
+#define LOAD_GEN_MUTEX_NAME        "PL_SIM_LG_MUTEX"
+
+
+/******************************************************************************
+** Telemetry Shaper
+**
+** Each output class has a backlog queue of TLM_SHAPER_BACKLOG_PKT_MAX packets
+** and packets larger than TLM_SHAPER_PKT_LEN_MAX are dropped when they can't
+** be sent immediately. A shaped class's burst size is at least
+** TLM_SHAPER_PKT_LEN_MAX.
+*/
+
+#define TLM_SHAPER_BACKLOG_PKT_MAX    8
+#define TLM_SHAPER_PKT_LEN_MAX      256
+
+
+/******************************************************************************
+** Configuration Cache
+**
+** Buffer size used to read the JSON init file when computing its CRC
+*/
+
+#define CFG_CACHE_FILE_BUF_LEN  512
+
+
+/******************************************************************************
+** Image Statistics
+**
+** Pixels are 8 bits. The histogram has 2^IMG_STATS_HIST_BIN_BITS bins and
+** IMG_STATS_HIST_BINS must match the ImageSummaryTlm Hist array size.
 */
 
-#define PL_SIM_POWER_ON_CMD_FC    (CMDMGR_APP_START_FC + 0)
-#define PL_SIM_POWER_OFF_CMD_FC   (CMDMGR_APP_START_FC + 1)
-#define PL_SIM_POWER_RESET_CMD_FC (CMDMGR_APP_START_FC + 2)
-#define PL_SIM_SET_FAULT_CMD_FC   (CMDMGR_APP_START_FC + 3)
-#define PL_SIM_CLEAR_FAULT_CMD_FC (CMDMGR_APP_START_FC + 4)
+#define IMG_STATS_HIST_BIN_BITS   4
+#define IMG_STATS_HIST_BINS      16
+#define IMG_STATS_SAT_VALUE     255
 
 
 /******************************************************************************
@@ -101,7 +194,11 @@ DECLARE_ENUM(Config,APP_CONFIG)
 ** exceeded so it is the developer's responsibility to verify the ranges. 
 */
 
-#define PL_SIM_BASE_EID  (APP_C_FW_APP_BASE_EID + 0)
+#define PL_SIM_BASE_EID     (APP_C_FW_APP_BASE_EID +  0)
+#define EVT_LOG_BASE_EID    (APP_C_FW_APP_BASE_EID + 20)
+#define LOAD_GEN_BASE_EID   (APP_C_FW_APP_BASE_EID + 40)
+#define CFG_CACHE_BASE_EID  (APP_C_FW_APP_BASE_EID + 60)
+#define TLM_SHAPER_BASE_EID (APP_C_FW_APP_BASE_EID + 80)
 
 
 /*
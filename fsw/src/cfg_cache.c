@@ -0,0 +1,280 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the binary configuration cache utilities
+**
+**  Notes:
+**    1. See header notes.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "cfg_cache.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CFG_CACHE_FILE_ID  0x504C5343  /* "PLSC" */
+#define CFG_CACHE_CRC_POLY 0xEDB88320  /* Reflected CRC-32 polynomial */
+#define CFG_CACHE_VERSION  ((PL_SIM_MAJOR_VER << 16) | (PL_SIM_MINOR_VER << 8) | PL_SIM_PLATFORM_REV)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  FileId;
+   uint32  Version;
+   uint32  SrcCrc;
+   uint32  SrcSize;
+   uint32  SchemaCrc;
+   uint32  MissionCrc;
+   uint32  CfgSize;
+   uint32  CfgCrc;
+
+} CFG_CACHE_FileHdr_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint32 ComputeMissionCrc(void);
+
+
+/******************************************************************************
+** Function: CFG_CACHE_CalculateCrc
+**
+** Notes:
+**   1. A bitwise implementation is used since the app only computes CRCs
+**      at initialization and when the configuration is reloaded.
+*/
+uint32 CFG_CACHE_CalculateCrc(const void *DataPtr, size_t DataLen, uint32 InputCrc)
+{
+
+   const uint8 *Byte = (const uint8*)DataPtr;
+   uint32 Crc = ~InputCrc;
+   size_t i;
+   uint16 Bit;
+
+   for (i=0; i < DataLen; i++)
+   {
+      Crc ^= Byte[i];
+      for (Bit=0; Bit < 8; Bit++)
+      {
+         Crc = (Crc >> 1) ^ (CFG_CACHE_CRC_POLY & (0 - (Crc & 1)));
+      }
+   }
+
+   return ~Crc;
+
+} /* End CFG_CACHE_CalculateCrc() */
+
+
+/******************************************************************************
+** Function: CFG_CACHE_ComputeFileCrc
+**
+*/
+bool CFG_CACHE_ComputeFileCrc(const char *Filename, uint32 *Crc, uint32 *Size)
+{
+
+   bool      RetStatus = false;
+   int32     ReadLen;
+   osal_id_t FileHandle;
+   uint8     Buf[CFG_CACHE_FILE_BUF_LEN];
+
+
+   *Crc  = 0;
+   *Size = 0;
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+
+      while ((ReadLen = OS_read(FileHandle, Buf, sizeof(Buf))) > 0)
+      {
+         *Crc   = CFG_CACHE_CalculateCrc(Buf, ReadLen, *Crc);
+         *Size += ReadLen;
+      }
+
+      OS_close(FileHandle);
+
+      RetStatus = (ReadLen == 0);
+
+   }
+
+   return RetStatus;
+
+} /* End CFG_CACHE_ComputeFileCrc() */
+
+
+/******************************************************************************
+** Function: CFG_CACHE_Read
+**
+*/
+bool CFG_CACHE_Read(const char *Filename, uint32 SrcCrc, uint32 SrcSize,
+                    uint32 SchemaCrc, void *CfgPtr, uint32 CfgSize)
+{
+
+   bool      RetStatus = false;
+   osal_id_t FileHandle;
+   CFG_CACHE_FileHdr_t FileHdr;
+
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+
+      if (OS_read(FileHandle, &FileHdr, sizeof(FileHdr)) == (int32)sizeof(FileHdr))
+      {
+
+         if (FileHdr.FileId  == CFG_CACHE_FILE_ID &&
+             FileHdr.Version == CFG_CACHE_VERSION &&
+             FileHdr.SrcCrc  == SrcCrc  &&
+             FileHdr.SrcSize == SrcSize &&
+             FileHdr.SchemaCrc == SchemaCrc &&
+             FileHdr.MissionCrc == ComputeMissionCrc() &&
+             FileHdr.CfgSize == CfgSize)
+         {
+
+            if (OS_read(FileHandle, CfgPtr, CfgSize) == (int32)CfgSize)
+            {
+               RetStatus = (CFG_CACHE_CalculateCrc(CfgPtr, CfgSize, 0) == FileHdr.CfgCrc);
+            }
+
+         }
+      } /* End if header read */
+
+      OS_close(FileHandle);
+
+   } /* End if file opened */
+
+   if (RetStatus)
+   {
+      CFE_EVS_SendEvent(CFG_CACHE_READ_EID, PL_SIM_INIT_EVS_TYPE,
+                        "Loaded configuration from cache file %s", Filename);
+   }
+
+   return RetStatus;
+
+} /* End CFG_CACHE_Read() */
+
+
+/******************************************************************************
+** Function: CFG_CACHE_Write
+**
+*/
+bool CFG_CACHE_Write(const char *Filename, uint32 SrcCrc, uint32 SrcSize,
+                     uint32 SchemaCrc, const void *CfgPtr, uint32 CfgSize)
+{
+
+   bool      RetStatus = false;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   CFG_CACHE_FileHdr_t FileHdr;
+
+
+   FileHdr.FileId  = CFG_CACHE_FILE_ID;
+   FileHdr.Version = CFG_CACHE_VERSION;
+   FileHdr.SrcCrc  = SrcCrc;
+   FileHdr.SrcSize   = SrcSize;
+   FileHdr.SchemaCrc = SchemaCrc;
+   FileHdr.MissionCrc = ComputeMissionCrc();
+   FileHdr.CfgSize   = CfgSize;
+   FileHdr.CfgCrc    = CFG_CACHE_CalculateCrc(CfgPtr, CfgSize, 0);
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      if (OS_write(FileHandle, &FileHdr, sizeof(FileHdr)) == (int32)sizeof(FileHdr))
+      {
+         RetStatus = (OS_write(FileHandle, CfgPtr, CfgSize) == (int32)CfgSize);
+      }
+
+      OS_close(FileHandle);
+
+      /* Don't leave a partial image that could be mistaken for a valid cache */
+      if (!RetStatus)
+      {
+         OS_remove(Filename);
+      }
+
+   }
+
+   if (RetStatus)
+   {
+      CFE_EVS_SendEvent(CFG_CACHE_WRITE_EID, PL_SIM_INIT_EVS_TYPE,
+                        "Wrote configuration cache file %s", Filename);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CFG_CACHE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to write configuration cache file %s, status = %d",
+                        Filename, (int)SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End CFG_CACHE_Write() */
+
+
+/******************************************************************************
+** Function: ComputeMissionCrc
+**
+** Compute a CRC that identifies the mission build and platform the app is
+** running on.
+**
+** Notes:
+**   1. Topic ID parameters are resolved to message IDs from the mission EDS
+**      topic map and the CPU so they can change without a JSON file change.
+**      The processor and spacecraft IDs identify the platform and the core
+**      build date changes whenever the mission, including its topic map,
+**      is rebuilt.
+*/
+static uint32 ComputeMissionCrc(void)
+{
+
+   uint32 Crc;
+   uint32 PlatformId[2];
+   const char *BuildDate;
+
+
+   PlatformId[0] = CFE_PSP_GetProcessorId();
+   PlatformId[1] = CFE_PSP_GetSpacecraftId();
+
+   Crc = CFG_CACHE_CalculateCrc(PlatformId, sizeof(PlatformId), 0);
+
+   BuildDate = CFE_Config_GetString(CFE_CONFIGID_CORE_BUILDINFO_DATE);
+   if (BuildDate != NULL)
+   {
+      Crc = CFG_CACHE_CalculateCrc(BuildDate, strlen(BuildDate), Crc);
+   }
+
+   return Crc;
+
+} /* End ComputeMissionCrc() */
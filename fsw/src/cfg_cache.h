@@ -0,0 +1,122 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the binary configuration cache utilities
+**
+**  Notes:
+**    1. The cache file contains a header followed by a binary image of the
+**       app's parsed configuration structure. The header identifies the JSON
+**       source file by its CRC and size and the image by the app version,
+**       a schema CRC, a mission CRC, its size and CRC.
+**    2. The schema CRC is computed by the caller from a description of the
+**       configuration layout, for example the stringified parameter list,
+**       so a layout change is detected without an app version change.
+**    3. A cache file is only used when every header field matches so a
+**       changed JSON file, a new app version or layout, a different mission
+**       build or platform or a corrupted cache file causes the caller to
+**       fall back to parsing the JSON file.
+**    4. Topic ID parameters are resolved from the mission EDS topic map and
+**       the CPU when the JSON file is parsed so the cached values can change
+**       while the JSON file doesn't. The mission CRC covers the processor
+**       ID, spacecraft ID and cFE core build date so a topic map or CPU
+**       mapping change invalidates the cache.
+**    5. All CRCs are CRC-32 (IEEE 802.3). cFE's CFE_ES_CalculateCRC() only
+**       provides a 16-bit CRC which is too weak to identify the source file.
+**    6. These are stateless utilities so there is no constructor.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+#ifndef _cfg_cache_
+#define _cfg_cache_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define CFG_CACHE_READ_EID       (CFG_CACHE_BASE_EID + 0)
+#define CFG_CACHE_WRITE_EID      (CFG_CACHE_BASE_EID + 1)
+#define CFG_CACHE_WRITE_ERR_EID  (CFG_CACHE_BASE_EID + 2)
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CFG_CACHE_CalculateCrc
+**
+** Compute the CRC-32 of a block of data.
+**
+** Notes:
+**  1. InputCrc is the CRC returned for the previous block, or 0 for the
+**     first block, so a CRC can be computed over multiple blocks.
+**
+*/
+uint32 CFG_CACHE_CalculateCrc(const void *DataPtr, size_t DataLen, uint32 InputCrc);
+
+
+/******************************************************************************
+** Function: CFG_CACHE_ComputeFileCrc
+**
+** Compute the CRC and size of a configuration source file.
+**
+*/
+bool CFG_CACHE_ComputeFileCrc(const char *Filename, uint32 *Crc, uint32 *Size);
+
+
+/******************************************************************************
+** Function: CFG_CACHE_Read
+**
+** Load a configuration image from a cache file if it was created from a
+** source file with the same CRC and size and a configuration with the same
+** schema CRC on the same mission build and platform.
+**
+** Notes:
+**  1. Returns false if the cache file doesn't exist or fails any validation
+**     check. The contents of CfgPtr are undefined when false is returned.
+**
+*/
+bool CFG_CACHE_Read(const char *Filename, uint32 SrcCrc, uint32 SrcSize,
+                    uint32 SchemaCrc, void *CfgPtr, uint32 CfgSize);
+
+
+/******************************************************************************
+** Function: CFG_CACHE_Write
+**
+** Write a configuration image, its schema CRC, the mission CRC and its
+** source file identification to a cache file.
+**
+*/
+bool CFG_CACHE_Write(const char *Filename, uint32 SrcCrc, uint32 SrcSize,
+                     uint32 SchemaCrc, const void *CfgPtr, uint32 CfgSize);
+
+
+#endif /* _cfg_cache_ */
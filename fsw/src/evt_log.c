@@ -0,0 +1,289 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the deferred event log
+**
+**  Notes:
+**    1. See header notes.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "evt_log.h"
+#include "fileutil.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+CompileTimeAssert((EVT_LOG_REC_MAX & (EVT_LOG_REC_MAX-1)) == 0, EVT_LOG_RecMaxNotPowerOf2);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static EVT_LOG_Class_t *EvtLog = NULL;
+
+
+/******************************************************************************
+** Function: EVT_LOG_Constructor
+**
+** Notes:
+**   1. A FlushLim of 0 is rejected because records would never be sent to
+**      EVS.
+*/
+bool EVT_LOG_Constructor(EVT_LOG_Class_t *EvtLogPtr, uint32 FlushLim)
+{
+
+   bool RetStatus = false;
+
+   EvtLog = EvtLogPtr;
+
+   CFE_PSP_MemSet((void*)EvtLog, 0, sizeof(EVT_LOG_Class_t));
+
+   if (FlushLim > 0)
+   {
+      EvtLog->FlushLim = FlushLim;
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(EVT_LOG_CONSTRUCTOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Event log construction failed, flush limit must be greater than 0");
+   }
+
+   return RetStatus;
+
+} /* End EVT_LOG_Constructor() */
+
+
+/******************************************************************************
+** Function: EVT_LOG_DumpCmd
+**
+** Notes:
+**   1. The oldest record is at WriteCnt when the log has wrapped, otherwise
+**      it's at index 0.
+**   2. The ground supplied filename is copied to a local buffer so it's
+**      guaranteed to be terminated before it's verified and used.
+*/
+bool EVT_LOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_SIM_DumpEvtLog_CmdPayload_t *DumpCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_SIM_DumpEvtLog_t);
+
+   bool        RetStatus = false;
+   int32       SysStatus;
+   osal_id_t   FileHandle;
+   uint32      i;
+   uint32      RecCnt;
+   uint32      RecStart;
+   size_t      StrLen;
+   const EVT_LOG_Rec_t *Rec;
+   char  TimeStr[CFE_TIME_PRINTED_STRING_SIZE];
+   char  MsgStr[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+   char  LineStr[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH + CFE_TIME_PRINTED_STRING_SIZE + 32];
+   char  Filename[OS_MAX_PATH_LEN];
+
+
+   if (memchr(DumpCmd->Filename, '\0', sizeof(DumpCmd->Filename)) == NULL ||
+       strlen(DumpCmd->Filename) >= sizeof(Filename))
+   {
+      CFE_EVS_SendEvent(EVT_LOG_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Event log dump rejected, filename is not terminated or exceeds %d characters",
+                        (int)(sizeof(Filename) - 1));
+      return RetStatus;
+   }
+
+   strncpy(Filename, DumpCmd->Filename, sizeof(Filename) - 1);
+   Filename[sizeof(Filename) - 1] = '\0';
+
+   if (!FileUtil_VerifyFilenameStr(Filename))
+   {
+      CFE_EVS_SendEvent(EVT_LOG_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Event log dump rejected, invalid filename %s", Filename);
+      return RetStatus;
+   }
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      if (EvtLog->WriteCnt > EVT_LOG_REC_MAX)
+      {
+         RecCnt   = EVT_LOG_REC_MAX;
+         RecStart = EvtLog->WriteCnt - EVT_LOG_REC_MAX;
+      }
+      else
+      {
+         RecCnt   = EvtLog->WriteCnt;
+         RecStart = 0;
+      }
+
+      sprintf(LineStr, "PL_SIM event log: %u records, %u written, %u lost before flush\n",
+              (unsigned int)RecCnt, (unsigned int)EvtLog->WriteCnt, (unsigned int)EvtLog->LostCnt);
+      OS_write(FileHandle, LineStr, strlen(LineStr));
+
+      for (i=0; i < RecCnt; i++)
+      {
+
+         Rec = &EvtLog->Rec[(RecStart + i) % EVT_LOG_REC_MAX];
+
+         CFE_TIME_Print(TimeStr, Rec->Time);
+         snprintf(MsgStr, sizeof(MsgStr), Rec->Fmt, Rec->Arg[0], Rec->Arg[1], Rec->Arg[2]);
+         StrLen = snprintf(LineStr, sizeof(LineStr), "%s EID %3u Type %u: %s\n",
+                           TimeStr, Rec->EventId, Rec->EventType, MsgStr);
+         if (StrLen >= sizeof(LineStr))
+         {
+            StrLen = sizeof(LineStr) - 1;
+         }
+         OS_write(FileHandle, LineStr, StrLen);
+
+      } /* End record loop */
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(EVT_LOG_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                        "Dumped %u event log records to %s",
+                        (unsigned int)RecCnt, Filename);
+
+      RetStatus = true;
+
+   } /* End if file opened */
+   else
+   {
+
+      CFE_EVS_SendEvent(EVT_LOG_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Event log dump failed to create file %s, status = %d",
+                        Filename, (int)SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End EVT_LOG_DumpCmd() */
+
+
+/******************************************************************************
+** Function: EVT_LOG_Flush
+**
+** Notes:
+**   1. The format string is passed all EVT_LOG_ARG_MAX arguments. Unused
+**      arguments are ignored by the formatter.
+*/
+void EVT_LOG_Flush(void)
+{
+
+   uint32 FlushCnt = 0;
+   const EVT_LOG_Rec_t *Rec;
+
+   if ((EvtLog->WriteCnt - EvtLog->FlushCnt) > EVT_LOG_REC_MAX)
+   {
+      EvtLog->LostCnt += (EvtLog->WriteCnt - EvtLog->FlushCnt) - EVT_LOG_REC_MAX;
+      EvtLog->FlushCnt = EvtLog->WriteCnt - EVT_LOG_REC_MAX;
+   }
+
+   while ((EvtLog->FlushCnt != EvtLog->WriteCnt) && (FlushCnt < EvtLog->FlushLim))
+   {
+
+      Rec = &EvtLog->Rec[EvtLog->FlushCnt % EVT_LOG_REC_MAX];
+
+      CFE_EVS_SendTimedEvent(Rec->Time, Rec->EventId, Rec->EventType, Rec->Fmt,
+                             Rec->Arg[0], Rec->Arg[1], Rec->Arg[2]);
+
+      EvtLog->FlushCnt++;
+      FlushCnt++;
+
+   }
+
+} /* End EVT_LOG_Flush() */
+
+
+/******************************************************************************
+** Function: EVT_LOG_ResetStatus
+**
+*/
+void EVT_LOG_ResetStatus(void)
+{
+
+   EvtLog->LostCnt = 0;
+
+} /* End EVT_LOG_ResetStatus() */
+
+
+/******************************************************************************
+** Function: EVT_LOG_SetFlushLim
+**
+*/
+bool EVT_LOG_SetFlushLim(uint32 FlushLim)
+{
+
+   bool RetStatus = false;
+
+   if (FlushLim > 0)
+   {
+      EvtLog->FlushLim = FlushLim;
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(EVT_LOG_SET_FLUSH_LIM_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Event log flush limit 0 rejected, current limit %u retained",
+                        (unsigned int)EvtLog->FlushLim);
+   }
+
+   return RetStatus;
+
+} /* End EVT_LOG_SetFlushLim() */
+
+
+/******************************************************************************
+** Function: EVT_LOG_Write
+**
+*/
+void EVT_LOG_Write(uint16 EventId, uint16 EventType, const char *Fmt, uint16 ArgCnt, ...)
+{
+
+   va_list ArgPtr;
+   uint16  i;
+   EVT_LOG_Rec_t *Rec = &EvtLog->Rec[EvtLog->WriteCnt % EVT_LOG_REC_MAX];
+
+   Rec->Time      = CFE_TIME_GetTime();
+   Rec->Fmt       = Fmt;
+   Rec->EventId   = EventId;
+   Rec->EventType = EventType;
+
+   va_start(ArgPtr, ArgCnt);
+   for (i=0; i < EVT_LOG_ARG_MAX; i++)
+   {
+      Rec->Arg[i] = (i < ArgCnt) ? va_arg(ArgPtr, int32) : 0;
+   }
+   va_end(ArgPtr);
+
+   EvtLog->WriteCnt++;
+
+} /* End EVT_LOG_Write() */
+
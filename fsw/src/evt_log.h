@@ -0,0 +1,192 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the deferred event log
+**
+**  Notes:
+**    1. Event messages are stored as fixed size binary records containing
+**       the event ID, a timestamp, a pointer to the format string and raw
+**       integer arguments. No string formatting is performed when an event
+**       is written so it's safe to use on the app's command/tick path.
+**    2. Records are formatted later by EVT_LOG_Flush() which sends a limited
+**       number of records to EVS each execution cycle and by the dump
+**       command that writes the log to a text file.
+**    3. The log is a ring buffer. When it's full the oldest record is
+**       overwritten. Records overwritten before they were flushed to EVS
+**       are counted in LostCnt.
+**    4. Format strings must be string literals because only the pointer is
+**       stored and the arguments must be integers since they're stored
+**       as int32.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+#ifndef _evt_log_
+#define _evt_log_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define EVT_LOG_DUMP_EID              (EVT_LOG_BASE_EID + 0)
+#define EVT_LOG_DUMP_ERR_EID          (EVT_LOG_BASE_EID + 1)
+#define EVT_LOG_CONSTRUCTOR_ERR_EID   (EVT_LOG_BASE_EID + 2)
+#define EVT_LOG_SET_FLUSH_LIM_ERR_EID (EVT_LOG_BASE_EID + 3)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Event record
+*/
+
+typedef struct
+{
+
+   CFE_TIME_SysTime_t  Time;
+   const char         *Fmt;
+   uint16              EventId;
+   uint16              EventType;
+   int32               Arg[EVT_LOG_ARG_MAX];
+
+} EVT_LOG_Rec_t;
+
+
+/******************************************************************************
+** Class definition
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+
+   uint32  FlushLim;
+
+   /*
+   ** Class State Data
+   */
+
+   uint32  WriteCnt;   /* Total records written, Rec index = WriteCnt % EVT_LOG_REC_MAX */
+   uint32  FlushCnt;   /* Total records flushed to EVS or skipped because they were lost */
+   uint32  LostCnt;    /* Records overwritten before they were flushed */
+
+   EVT_LOG_Rec_t Rec[EVT_LOG_REC_MAX];
+
+} EVT_LOG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: EVT_LOG_Constructor
+**
+** Initialize the event log to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. FlushLim is the maximum number of records sent to EVS each time
+**      EVT_LOG_Flush() is called. Returns false if FlushLim is 0.
+**
+*/
+bool EVT_LOG_Constructor(EVT_LOG_Class_t *EvtLogPtr, uint32 FlushLim);
+
+
+/******************************************************************************
+** Function: EVT_LOG_DumpCmd
+**
+** Format the event log records and write them to a text file. Records are
+** written from oldest to newest.
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. The dump does not change the flush state of the records.
+**
+*/
+bool EVT_LOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: EVT_LOG_Flush
+**
+** Send up to FlushLim unflushed records to EVS using the time stored in each
+** record.
+**
+** Notes:
+**  1. Intended to be called once per execution cycle after the app has
+**     completed its time critical processing.
+**
+*/
+void EVT_LOG_Flush(void);
+
+
+/******************************************************************************
+** Function: EVT_LOG_ResetStatus
+**
+** Reset counters without clearing the log records.
+**
+*/
+void EVT_LOG_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: EVT_LOG_SetFlushLim
+**
+** Change the maximum number of records sent to EVS each execution cycle.
+**
+** Notes:
+**  1. A FlushLim of 0 is rejected and the current limit is retained.
+**
+*/
+bool EVT_LOG_SetFlushLim(uint32 FlushLim);
+
+
+/******************************************************************************
+** Function: EVT_LOG_Write
+**
+** Store an event record without formatting it.
+**
+** Notes:
+**  1. Fmt must be a string literal. See file prologue.
+**  2. ArgCnt int32 arguments follow ArgCnt and any beyond EVT_LOG_ARG_MAX
+**     are ignored.
+**
+*/
+void EVT_LOG_Write(uint16 EventId, uint16 EventType, const char *Fmt, uint16 ArgCnt, ...);
+
+
+#endif /* _evt_log_ */
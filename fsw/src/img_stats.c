@@ -0,0 +1,227 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the incremental image statistics
+**
+**  Notes:
+**    1. See header notes.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "img_stats.h"
+#include "tlm_shaper.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define IMG_STATS_HIST_SHIFT  (8 - IMG_STATS_HIST_BIN_BITS)
+
+CompileTimeAssert(IMG_STATS_HIST_BINS == (1 << IMG_STATS_HIST_BIN_BITS), IMG_STATS_HistBinsMismatch);
+CompileTimeAssert(sizeof(((PL_SIM_ImageSummaryTlm_Payload_t*)0)->Hist) == IMG_STATS_HIST_BINS*sizeof(uint32),
+                  IMG_STATS_HistTlmMismatch);
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AccumulateRow(const uint8 *Row, uint16 RowLen);
+static void ClearImage(void);
+static void SendImageSummaryTlm(uint16 ImageCnt);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static IMG_STATS_Class_t *ImgStats = NULL;
+
+
+/******************************************************************************
+** Function: IMG_STATS_Constructor
+**
+*/
+void IMG_STATS_Constructor(IMG_STATS_Class_t *ImgStatsPtr, CFE_SB_MsgId_t TlmMid)
+{
+
+   ImgStats = ImgStatsPtr;
+
+   CFE_PSP_MemSet((void*)ImgStats, 0, sizeof(IMG_STATS_Class_t));
+   ClearImage();
+
+   CFE_MSG_Init(CFE_MSG_PTR(ImgStats->Tlm.TelemetryHeader), TlmMid, sizeof(PL_SIM_ImageSummaryTlm_t));
+
+} /* End IMG_STATS_Constructor() */
+
+
+/******************************************************************************
+** Function: IMG_STATS_Execute
+**
+** Notes:
+**   1. A row that's read in the same cycle the image completes belongs to
+**      the completed image so it's accumulated before the summary is sent.
+**   2. A row is only accumulated when ReadoutRow moves forward. The row
+**      buffer isn't a new row when ReadoutRow moves back, for example when
+**      it's reset to zero after an image completes.
+**   3. A partial image is reported with the image count it would have had
+**      when it completed.
+*/
+void IMG_STATS_Execute(bool ReadoutActive, uint16 ImageCnt, uint16 ReadoutRow,
+                       const uint8 *Row, uint16 RowLen)
+{
+
+   if (ReadoutActive && ReadoutRow > ImgStats->PrevReadoutRow)
+   {
+      AccumulateRow(Row, RowLen);
+   }
+
+   if (ImageCnt != ImgStats->PrevImageCnt)
+   {
+      if (ImgStats->RowCnt > 0)
+      {
+         SendImageSummaryTlm(ImageCnt);
+      }
+      ClearImage();
+   }
+   else if ((!ReadoutActive || ReadoutRow < ImgStats->PrevReadoutRow) && ImgStats->RowCnt > 0)
+   {
+      /* Readout stopped or restarted before the image completed */
+      SendImageSummaryTlm((uint16)(ImageCnt + 1));
+      ClearImage();
+   }
+
+   ImgStats->PrevImageCnt   = ImageCnt;
+   ImgStats->PrevReadoutRow = ReadoutRow;
+
+} /* End IMG_STATS_Execute() */
+
+
+/******************************************************************************
+** Function: AccumulateRow
+**
+** Notes:
+**   1. The first loop only contains reductions so it can be vectorized. The
+**      histogram and saturation counts are computed in a separate loop.
+**   2. The row's integer sums are exact so the row's M2 has no cancellation
+**      error before it's merged.
+*/
+static void AccumulateRow(const uint8 *Row, uint16 RowLen)
+{
+
+   uint16  i;
+   uint8   RowMin = 0xFF;
+   uint8   RowMax = 0;
+   uint32  RowSum = 0;
+   uint64  RowSumSq = 0;
+   double  RowMean;
+   double  RowM2;
+   double  Delta;
+   uint32  NewPixelCnt;
+
+   if (RowLen == 0)
+   {
+      return;
+   }
+
+   for (i=0; i < RowLen; i++)
+   {
+      RowSum   += Row[i];
+      RowSumSq += (uint32)Row[i] * Row[i];
+      RowMin    = (Row[i] < RowMin) ? Row[i] : RowMin;
+      RowMax    = (Row[i] > RowMax) ? Row[i] : RowMax;
+   }
+
+   for (i=0; i < RowLen; i++)
+   {
+      ImgStats->Hist[Row[i] >> IMG_STATS_HIST_SHIFT]++;
+      ImgStats->SatCnt += (Row[i] >= IMG_STATS_SAT_VALUE);
+   }
+
+   RowMean = (double)RowSum / RowLen;
+   RowM2   = ((double)RowSumSq * RowLen - (double)RowSum * RowSum) / RowLen;
+
+   /* Chan et al. merge of the row into the image totals */
+   NewPixelCnt = ImgStats->PixelCnt + RowLen;
+   Delta = RowMean - ImgStats->Mean;
+   ImgStats->Mean += Delta * RowLen / NewPixelCnt;
+   ImgStats->M2   += RowM2 + Delta * Delta * ((double)ImgStats->PixelCnt * RowLen / NewPixelCnt);
+   ImgStats->PixelCnt = NewPixelCnt;
+
+   ImgStats->Min = (RowMin < ImgStats->Min) ? RowMin : ImgStats->Min;
+   ImgStats->Max = (RowMax > ImgStats->Max) ? RowMax : ImgStats->Max;
+   ImgStats->RowCnt++;
+
+} /* End AccumulateRow() */
+
+
+/******************************************************************************
+** Function: ClearImage
+**
+*/
+static void ClearImage(void)
+{
+
+   ImgStats->RowCnt   = 0;
+   ImgStats->PixelCnt = 0;
+   ImgStats->Min      = 0xFF;
+   ImgStats->Max      = 0;
+   ImgStats->Mean     = 0.0;
+   ImgStats->M2       = 0.0;
+   ImgStats->SatCnt   = 0;
+
+   CFE_PSP_MemSet((void*)ImgStats->Hist, 0, sizeof(ImgStats->Hist));
+
+} /* End ClearImage() */
+
+
+/******************************************************************************
+** Function: SendImageSummaryTlm
+**
+*/
+static void SendImageSummaryTlm(uint16 ImageCnt)
+{
+
+   PL_SIM_ImageSummaryTlm_Payload_t *Payload = &ImgStats->Tlm.Payload;
+   uint16 i;
+
+   Payload->ImageCnt = ImageCnt;
+   Payload->RowCnt   = ImgStats->RowCnt;
+   Payload->PixelCnt = ImgStats->PixelCnt;
+   Payload->Min      = ImgStats->Min;
+   Payload->Max      = ImgStats->Max;
+   Payload->Mean     = (float)ImgStats->Mean;
+   Payload->Variance = (float)(ImgStats->M2 / ImgStats->PixelCnt);
+   Payload->SatCnt   = ImgStats->SatCnt;
+
+   for (i=0; i < IMG_STATS_HIST_BINS; i++)
+   {
+      Payload->Hist[i] = ImgStats->Hist[i];
+   }
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(ImgStats->Tlm.TelemetryHeader));
+   TLM_SHAPER_Transmit(TLM_SHAPER_SCIENCE, CFE_MSG_PTR(ImgStats->Tlm.TelemetryHeader));
+
+} /* End SendImageSummaryTlm() */
+
@@ -0,0 +1,130 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the incremental image statistics
+**
+**  Notes:
+**    1. Statistics are accumulated one detector row at a time as the
+**       simulated detector is read out so an image summary is available
+**       without a second pass over the image.
+**    2. Each row is reduced with simple integer loops that compilers can
+**       vectorize. The row's mean and sum of squared differences are then
+**       merged into the image totals using Chan's parallel variance
+**       algorithm which remains numerically stable for large images.
+**    3. An ImageSummaryTlm packet is sent through the science output class
+**       of the telemetry shaper as soon as the image count changes. A
+**       summary is also sent when readout stops or restarts before the
+**       image completes, for example when the detector is powered off during
+**       readout. A RowCnt less than the detector's row count identifies
+**       these partial images.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+#ifndef _img_stats_
+#define _img_stats_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Telemetry Packets
+** - See EDS command definitions in pl_sim.xml
+*/
+
+
+/******************************************************************************
+** Class definition
+*/
+
+typedef struct
+{
+
+   /*
+   ** Readout tracking
+   */
+
+   uint16  PrevImageCnt;
+   uint16  PrevReadoutRow;
+
+   /*
+   ** Image accumulators
+   */
+
+   uint16  RowCnt;
+   uint32  PixelCnt;
+   uint8   Min;
+   uint8   Max;
+   double  Mean;
+   double  M2;
+   uint32  SatCnt;
+   uint32  Hist[IMG_STATS_HIST_BINS];
+
+   /*
+   ** Telemetry
+   */
+
+   PL_SIM_ImageSummaryTlm_t  Tlm;
+
+} IMG_STATS_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: IMG_STATS_Constructor
+**
+** Initialize the image statistics to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void IMG_STATS_Constructor(IMG_STATS_Class_t *ImgStatsPtr, CFE_SB_MsgId_t TlmMid);
+
+
+/******************************************************************************
+** Function: IMG_STATS_Execute
+**
+** Accumulate a newly read detector row and send the image summary when the
+** image count changes.
+**
+** Notes:
+**  1. Must be called once per execution cycle after the detector state has
+**     been read. Row is only used when ReadoutRow has moved forward.
+**  2. ReadoutActive is false when the detector can't be read out, for
+**     example when it's powered off or faulted. A partially accumulated
+**     image is reported and cleared when readout stops.
+**
+*/
+void IMG_STATS_Execute(bool ReadoutActive, uint16 ImageCnt, uint16 ReadoutRow,
+                       const uint8 *Row, uint16 RowLen);
+
+
+#endif /* _img_stats_ */
@@ -0,0 +1,590 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the command load generator
+**
+**  Notes:
+**    1. See header notes.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "load_gen.h"
+#include "tlm_shaper.h"
+#include "pl_sim_eds_cc.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AccountCycle(uint16 ValidCmdCnt, uint16 InvalidCmdCnt);
+static void ChildTask(void);
+static void ClearStepData(void);
+static void InitCmdMsgs(CFE_SB_MsgId_t CmdMid);
+static void SendBurst(uint16 BurstLen, uint8 InvalidPct, uint16 *InvalidAcc,
+                      uint32 *ValidSent, uint32 *InvalidSent);
+static void SendTlm(void);
+static void StartSending(void);
+static void StopSending(void);
+static void UpdateTickTiming(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static LOAD_GEN_Class_t *LoadGen = NULL;
+
+
+/******************************************************************************
+** Function: LOAD_GEN_Constructor
+**
+*/
+void LOAD_GEN_Constructor(LOAD_GEN_Class_t *LoadGenPtr, CFE_SB_MsgId_t CmdMid,
+                          CFE_SB_MsgId_t TlmMid, uint16 PipeDepth)
+{
+
+   int32 SysStatus;
+
+   LoadGen = LoadGenPtr;
+
+   CFE_PSP_MemSet((void*)LoadGen, 0, sizeof(LOAD_GEN_Class_t));
+
+   LoadGen->CmdMid    = CmdMid;
+   LoadGen->PipeDepth = PipeDepth;
+
+   CFE_MSG_Init(CFE_MSG_PTR(LoadGen->Tlm.TelemetryHeader), TlmMid, sizeof(PL_SIM_LoadGenTlm_t));
+
+   SysStatus = OS_MutSemCreate(&LoadGen->MutexId, LOAD_GEN_MUTEX_NAME, 0);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+      SysStatus = CFE_ES_CreateChildTask(&LoadGen->ChildTaskId, LOAD_GEN_CHILD_NAME, ChildTask,
+                                         CFE_ES_TASK_STACK_ALLOCATE, LOAD_GEN_CHILD_STACK_SIZE,
+                                         LOAD_GEN_CHILD_PRIORITY, 0);
+   }
+
+   if (SysStatus == CFE_SUCCESS)
+   {
+      LoadGen->ChildTaskReady = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(LOAD_GEN_CHILD_TASK_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Load generator child task creation failed, status = %d. Tests are disabled.",
+                        (int)SysStatus);
+   }
+
+} /* End LOAD_GEN_Constructor() */
+
+
+/******************************************************************************
+** Function: LOAD_GEN_Execute
+**
+** Notes:
+**   1. The child task stops sending at the start of the settle cycle so all
+**      commands sent during the step have been processed or dropped by the
+**      time the following execution cycle message is read from the pipe.
+*/
+void LOAD_GEN_Execute(uint16 ValidCmdCnt, uint16 InvalidCmdCnt)
+{
+
+   if (LoadGen->Active)
+   {
+
+      if (LoadGen->FirstCycle)
+      {
+
+         LoadGen->PrevValidCmdCnt   = ValidCmdCnt;
+         LoadGen->PrevInvalidCmdCnt = InvalidCmdCnt;
+         LoadGen->PrevTickTime      = CFE_TIME_GetTime();
+         LoadGen->FirstCycle        = false;
+
+         StartSending();
+
+      }
+      else
+      {
+
+         UpdateTickTiming();
+         AccountCycle(ValidCmdCnt, InvalidCmdCnt);
+
+         if (LoadGen->Settling)
+         {
+
+            SendTlm();
+
+            if ((LoadGen->Rate + LoadGen->RateStep) > LoadGen->MaxRate || LoadGen->RateStep == 0)
+            {
+
+               LoadGen->Active = false;
+
+               CFE_EVS_SendEvent(LOAD_GEN_COMPLETE_EID, CFE_EVS_EventType_INFORMATION,
+                                 "Load generator test completed after %d steps, final rate %d cmds/sec",
+                                 LoadGen->Step + 1, LoadGen->Rate);
+            }
+            else
+            {
+
+               LoadGen->Step++;
+               LoadGen->Rate += LoadGen->RateStep;
+               ClearStepData();
+               StartSending();
+
+            }
+         } /* End if settling */
+         else
+         {
+
+            LoadGen->CycleCnt++;
+
+            if (LoadGen->CycleCnt >= LoadGen->StepCycles)
+            {
+               StopSending();
+               LoadGen->Settling = true;
+            }
+
+         }
+      } /* End if not first cycle */
+
+   } /* End if active */
+
+} /* End LOAD_GEN_Execute() */
+
+
+/******************************************************************************
+** Function: LOAD_GEN_SetConfig
+**
+*/
+void LOAD_GEN_SetConfig(CFE_SB_MsgId_t CmdMid, CFE_SB_MsgId_t TlmMid, uint16 PipeDepth)
+{
+
+   if (LoadGen->Active)
+   {
+
+      StopSending();
+      LoadGen->Active = false;
+
+      CFE_EVS_SendEvent(LOAD_GEN_CONFIG_EID, CFE_EVS_EventType_INFORMATION,
+                        "Load generator test stopped by a configuration change at step %d, rate %d cmds/sec",
+                        LoadGen->Step, LoadGen->Rate);
+   }
+
+   OS_MutSemTake(LoadGen->MutexId);
+   LoadGen->CmdMid = CmdMid;
+   OS_MutSemGive(LoadGen->MutexId);
+
+   LoadGen->PipeDepth = PipeDepth;
+
+   CFE_MSG_Init(CFE_MSG_PTR(LoadGen->Tlm.TelemetryHeader), TlmMid, sizeof(PL_SIM_LoadGenTlm_t));
+
+} /* End LOAD_GEN_SetConfig() */
+
+
+/******************************************************************************
+** Function: LOAD_GEN_StartCmd
+**
+** Notes:
+**   1. The child task sends at most LOAD_GEN_RATE_MAX*LOAD_GEN_CHILD_PERIOD_MS/1000
+**      plus LOAD_GEN_BURST_LEN_MAX commands each time it runs so the limits
+**      bound the time the app can be blocked by a single burst.
+*/
+bool LOAD_GEN_StartCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_SIM_StartLoadGen_CmdPayload_t *StartCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_SIM_StartLoadGen_t);
+
+   bool RetStatus = false;
+
+
+   if (!LoadGen->ChildTaskReady)
+   {
+
+      CFE_EVS_SendEvent(LOAD_GEN_START_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Start load generator rejected, the child task was not created");
+
+   }
+   else if (LoadGen->Active)
+   {
+
+      CFE_EVS_SendEvent(LOAD_GEN_START_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Start load generator rejected, a test is already active");
+
+   }
+   else if (StartCmd->StartRate > StartCmd->MaxRate || StartCmd->MaxRate > LOAD_GEN_RATE_MAX ||
+            StartCmd->StepCycles == 0 || StartCmd->BurstLen == 0 ||
+            StartCmd->BurstLen > LOAD_GEN_BURST_LEN_MAX || StartCmd->InvalidPct > 100)
+   {
+
+      CFE_EVS_SendEvent(LOAD_GEN_START_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Start load generator rejected, invalid parameters: Rate %d..%d (max %d), StepCycles %d, BurstLen %d (max %d), InvalidPct %d",
+                        StartCmd->StartRate, StartCmd->MaxRate, LOAD_GEN_RATE_MAX, StartCmd->StepCycles,
+                        StartCmd->BurstLen, LOAD_GEN_BURST_LEN_MAX, StartCmd->InvalidPct);
+
+   }
+   else
+   {
+
+      LoadGen->RateStep   = StartCmd->RateStep;
+      LoadGen->MaxRate    = StartCmd->MaxRate;
+      LoadGen->StepCycles = StartCmd->StepCycles;
+
+      OS_MutSemTake(LoadGen->MutexId);
+      LoadGen->BurstLen   = StartCmd->BurstLen;
+      LoadGen->InvalidPct = StartCmd->InvalidPct;
+      OS_MutSemGive(LoadGen->MutexId);
+
+      LoadGen->Step       = 0;
+      LoadGen->Rate       = StartCmd->StartRate;
+      LoadGen->FirstCycle = true;
+      LoadGen->Active     = true;
+      ClearStepData();
+
+      CFE_EVS_SendEvent(LOAD_GEN_START_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Load generator started: Rate %d..%d step %d cmds/sec, StepCycles %d, BurstLen %d, InvalidPct %d",
+                        StartCmd->StartRate, StartCmd->MaxRate, StartCmd->RateStep,
+                        StartCmd->StepCycles, StartCmd->BurstLen, StartCmd->InvalidPct);
+
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End LOAD_GEN_StartCmd() */
+
+
+/******************************************************************************
+** Function: LOAD_GEN_StopCmd
+**
+** Notes:
+**   1. Commands still in the pipe when the test is stopped are not accounted
+**      for in the partial step telemetry.
+*/
+bool LOAD_GEN_StopCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   if (LoadGen->Active)
+   {
+
+      StopSending();
+      LoadGen->Active = false;
+      SendTlm();
+
+   }
+
+   CFE_EVS_SendEvent(LOAD_GEN_STOP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Load generator stopped at step %d, rate %d cmds/sec",
+                     LoadGen->Step, LoadGen->Rate);
+
+   return true;
+
+} /* End LOAD_GEN_StopCmd() */
+
+
+/******************************************************************************
+** Function: AccountCycle
+**
+** Notes:
+**   1. The command manager counters are 16 bits so the deltas rely on
+**      unsigned rollover.
+*/
+static void AccountCycle(uint16 ValidCmdCnt, uint16 InvalidCmdCnt)
+{
+
+   LoadGen->ValidRcvd   += (uint16)(ValidCmdCnt - LoadGen->PrevValidCmdCnt);
+   LoadGen->InvalidRcvd += (uint16)(InvalidCmdCnt - LoadGen->PrevInvalidCmdCnt);
+
+   LoadGen->PrevValidCmdCnt   = ValidCmdCnt;
+   LoadGen->PrevInvalidCmdCnt = InvalidCmdCnt;
+
+} /* End AccountCycle() */
+
+
+/******************************************************************************
+** Function: ChildTask
+**
+** Notes:
+**   1. The shared test parameters are copied while the mutex is held and the
+**      commands are sent without it so the main task is never blocked by a
+**      burst.
+**   2. Credit accumulates Rate*LOAD_GEN_CHILD_PERIOD_MS each period and a
+**      burst is sent each time it covers BurstLen commands. It's reset when
+**      a new step starts.
+**   3. Sent counts are discarded if a new step started while they were
+**      being sent.
+**   4. The task runs until cFE deletes it when the app exits.
+*/
+static void ChildTask(void)
+{
+
+   bool    Sending;
+   uint16  StepSeq;
+   uint16  Rate = 0;
+   uint16  BurstLen = 1;
+   uint8   InvalidPct = 0;
+   CFE_SB_MsgId_t CmdMid = CFE_SB_INVALID_MSG_ID;
+   uint16  ChildStepSeq = 0;
+   uint32  Credit = 0;
+   uint16  InvalidAcc = 0;
+   uint32  ValidSent;
+   uint32  InvalidSent;
+
+   while (true)
+   {
+
+      OS_TaskDelay(LOAD_GEN_CHILD_PERIOD_MS);
+
+      OS_MutSemTake(LoadGen->MutexId);
+      Sending = LoadGen->Sending;
+      StepSeq = LoadGen->StepSeq;
+      if (Sending && StepSeq != ChildStepSeq)
+      {
+         Rate       = LoadGen->Rate;
+         BurstLen   = LoadGen->BurstLen;
+         InvalidPct = LoadGen->InvalidPct;
+         CmdMid     = LoadGen->CmdMid;
+      }
+      OS_MutSemGive(LoadGen->MutexId);
+
+      if (Sending)
+      {
+
+         if (StepSeq != ChildStepSeq)
+         {
+            InitCmdMsgs(CmdMid);
+            ChildStepSeq = StepSeq;
+            Credit       = 0;
+            InvalidAcc   = 0;
+         }
+
+         ValidSent   = 0;
+         InvalidSent = 0;
+
+         Credit += (uint32)Rate * LOAD_GEN_CHILD_PERIOD_MS;
+         while (Credit >= (uint32)BurstLen * 1000)
+         {
+            Credit -= (uint32)BurstLen * 1000;
+            SendBurst(BurstLen, InvalidPct, &InvalidAcc, &ValidSent, &InvalidSent);
+         }
+
+         OS_MutSemTake(LoadGen->MutexId);
+         if (LoadGen->StepSeq == ChildStepSeq)
+         {
+            LoadGen->ValidSent   += ValidSent;
+            LoadGen->InvalidSent += InvalidSent;
+         }
+         OS_MutSemGive(LoadGen->MutexId);
+
+      } /* End if sending */
+
+   } /* End task loop */
+
+} /* End ChildTask() */
+
+
+/******************************************************************************
+** Function: ClearStepData
+**
+*/
+static void ClearStepData(void)
+{
+
+   LoadGen->CycleCnt = 0;
+   LoadGen->Settling = false;
+
+   LoadGen->ValidRcvd   = 0;
+   LoadGen->InvalidRcvd = 0;
+
+   LoadGen->TickCnt           = 0;
+   LoadGen->TickLateCnt       = 0;
+   LoadGen->TickIntervalMaxMs = 0;
+   LoadGen->TickIntervalSumMs = 0;
+
+   OS_MutSemTake(LoadGen->MutexId);
+   LoadGen->ValidSent   = 0;
+   LoadGen->InvalidSent = 0;
+   OS_MutSemGive(LoadGen->MutexId);
+
+} /* End ClearStepData() */
+
+
+/******************************************************************************
+** Function: InitCmdMsgs
+**
+** Notes:
+**   1. Only called by the child task.
+*/
+static void InitCmdMsgs(CFE_SB_MsgId_t CmdMid)
+{
+
+   CFE_MSG_Init((CFE_MSG_Message_t*)&LoadGen->ValidCmd, CmdMid, sizeof(PL_SIM_Noop_t));
+   CFE_MSG_SetFcnCode((CFE_MSG_Message_t*)&LoadGen->ValidCmd, PL_SIM_NOOP_CC);
+   CFE_MSG_GenerateChecksum((CFE_MSG_Message_t*)&LoadGen->ValidCmd);
+
+   CFE_MSG_Init((CFE_MSG_Message_t*)&LoadGen->InvalidCmd, CmdMid, sizeof(PL_SIM_Noop_t));
+   CFE_MSG_SetFcnCode((CFE_MSG_Message_t*)&LoadGen->InvalidCmd, LOAD_GEN_INVALID_CMD_FC);
+   CFE_MSG_GenerateChecksum((CFE_MSG_Message_t*)&LoadGen->InvalidCmd);
+
+} /* End InitCmdMsgs() */
+
+
+/******************************************************************************
+** Function: SendBurst
+**
+** Notes:
+**   1. Only called by the child task.
+**   2. Invalid commands are evenly distributed through the step using an
+**      accumulator so the mix is deterministic.
+*/
+static void SendBurst(uint16 BurstLen, uint8 InvalidPct, uint16 *InvalidAcc,
+                      uint32 *ValidSent, uint32 *InvalidSent)
+{
+
+   uint16 i;
+
+   for (i=0; i < BurstLen; i++)
+   {
+
+      *InvalidAcc += InvalidPct;
+
+      if (*InvalidAcc >= 100)
+      {
+         *InvalidAcc -= 100;
+         CFE_SB_TransmitMsg((CFE_MSG_Message_t*)&LoadGen->InvalidCmd, false);
+         (*InvalidSent)++;
+      }
+      else
+      {
+         CFE_SB_TransmitMsg((CFE_MSG_Message_t*)&LoadGen->ValidCmd, false);
+         (*ValidSent)++;
+      }
+
+   }
+
+} /* End SendBurst() */
+
+
+/******************************************************************************
+** Function: SendTlm
+**
+*/
+static void SendTlm(void)
+{
+
+   PL_SIM_LoadGenTlm_Payload_t *Payload = &LoadGen->Tlm.Payload;
+   uint32 Sent;
+   uint32 Rcvd = LoadGen->ValidRcvd + LoadGen->InvalidRcvd;
+
+   OS_MutSemTake(LoadGen->MutexId);
+   Payload->ValidSent   = LoadGen->ValidSent;
+   Payload->InvalidSent = LoadGen->InvalidSent;
+   Payload->BurstLen    = LoadGen->BurstLen;
+   OS_MutSemGive(LoadGen->MutexId);
+
+   Sent = Payload->ValidSent + Payload->InvalidSent;
+
+   Payload->Active    = LoadGen->Active;
+   Payload->Step      = LoadGen->Step;
+   Payload->Rate      = LoadGen->Rate;
+   Payload->PipeDepth = LoadGen->PipeDepth;
+   Payload->CycleCnt  = LoadGen->CycleCnt;
+
+   Payload->ValidRcvd   = LoadGen->ValidRcvd;
+   Payload->InvalidRcvd = LoadGen->InvalidRcvd;
+   Payload->DropCnt     = (Sent > Rcvd) ? (Sent - Rcvd) : 0;
+
+   Payload->TickLateCnt       = LoadGen->TickLateCnt;
+   Payload->TickIntervalMaxMs = LoadGen->TickIntervalMaxMs;
+   Payload->TickIntervalAvgMs = (LoadGen->TickCnt > 0) ? (LoadGen->TickIntervalSumMs / LoadGen->TickCnt) : 0;
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(LoadGen->Tlm.TelemetryHeader));
+   TLM_SHAPER_Transmit(TLM_SHAPER_STATUS, CFE_MSG_PTR(LoadGen->Tlm.TelemetryHeader));
+
+} /* End SendTlm() */
+
+
+/******************************************************************************
+** Function: StartSending
+**
+** Start the child task sending at the current step's rate.
+**
+** Notes:
+**   1. The step's rate is only changed while the child task isn't sending
+**      and the child task reads it after it sees the new StepSeq.
+*/
+static void StartSending(void)
+{
+
+   OS_MutSemTake(LoadGen->MutexId);
+   LoadGen->StepSeq++;
+   LoadGen->Sending = true;
+   OS_MutSemGive(LoadGen->MutexId);
+
+} /* End StartSending() */
+
+
+/******************************************************************************
+** Function: StopSending
+**
+*/
+static void StopSending(void)
+{
+
+   OS_MutSemTake(LoadGen->MutexId);
+   LoadGen->Sending = false;
+   OS_MutSemGive(LoadGen->MutexId);
+
+} /* End StopSending() */
+
+
+/******************************************************************************
+** Function: UpdateTickTiming
+**
+** Measure the time between execution cycle messages. A dropped execution
+** message shows up as an interval that's a multiple of the nominal period.
+*/
+static void UpdateTickTiming(void)
+{
+
+   CFE_TIME_SysTime_t CurrTime  = CFE_TIME_GetTime();
+   CFE_TIME_SysTime_t DeltaTime = CFE_TIME_Subtract(CurrTime, LoadGen->PrevTickTime);
+   uint32 IntervalMs = DeltaTime.Seconds * 1000 + CFE_TIME_Sub2MicroSecs(DeltaTime.Subseconds) / 1000;
+
+   LoadGen->PrevTickTime = CurrTime;
+
+   LoadGen->TickCnt++;
+   LoadGen->TickIntervalSumMs += IntervalMs;
+
+   if (IntervalMs > LoadGen->TickIntervalMaxMs)
+   {
+      LoadGen->TickIntervalMaxMs = IntervalMs;
+   }
+
+   if (IntervalMs > (LOAD_GEN_TICK_PERIOD_MS + LOAD_GEN_TICK_LATE_MS))
+   {
+      LoadGen->TickLateCnt++;
+   }
+
+} /* End UpdateTickTiming() */
+
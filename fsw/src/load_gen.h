@@ -0,0 +1,233 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the command load generator
+**
+**  Notes:
+**    1. The load generator is a stress test mode that publishes PL_SIM
+**       commands to the app's command MID and measures how many are
+**       processed. It's used to find the command rate at which the app
+**       starts dropping messages or receiving late execution ticks for a
+**       given command pipe configuration.
+**    2. Commands are sent by a child task so they arrive while the app's
+**       main task is reading the pipe, the same way commands from another
+**       app or the ground would. The child task runs every
+**       LOAD_GEN_CHILD_PERIOD_MS and sends whole bursts of BurstLen
+**       back-to-back commands so the average rate is Rate commands per
+**       second for any burst length.
+**    3. A test is a rate sweep. Each step sends at a fixed rate for
+**       StepCycles execution cycles and the rate is increased by RateStep
+**       after each step until MaxRate is exceeded. Sending stops for one
+**       settle cycle at the end of each step so every command sent during
+**       the step has been processed or dropped when a LoadGenTlm packet is
+**       sent. The ground can plot the throughput/drop/latency curve from
+**       these packets.
+**    4. Valid commands are no-ops and invalid commands use an unregistered
+**       function code. InvalidPct defines the mix. Messages with an unknown
+**       MID are not generated because SB only routes subscribed MIDs to the
+**       pipe so they don't load the app.
+**    5. Sent commands are compared against the command manager's valid and
+**       invalid counters. Any commands sent from the ground during a test
+**       are included in the received counts.
+**    6. SB reports each command dropped by a full pipe with an event that's
+**       limited by the SB platform event filter.
+**    7. Test parameters and the sent counters are shared between the main
+**       task and the child task and are protected by a mutex. The command
+**       messages are only used by the child task.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+#ifndef _load_gen_
+#define _load_gen_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define LOAD_GEN_START_CMD_EID      (LOAD_GEN_BASE_EID + 0)
+#define LOAD_GEN_START_CMD_ERR_EID  (LOAD_GEN_BASE_EID + 1)
+#define LOAD_GEN_STOP_CMD_EID       (LOAD_GEN_BASE_EID + 2)
+#define LOAD_GEN_COMPLETE_EID       (LOAD_GEN_BASE_EID + 3)
+#define LOAD_GEN_CHILD_TASK_ERR_EID (LOAD_GEN_BASE_EID + 4)
+#define LOAD_GEN_CONFIG_EID         (LOAD_GEN_BASE_EID + 5)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Telemetry Packets
+** - See EDS command definitions in pl_sim.xml
+*/
+
+
+/******************************************************************************
+** Class definition
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+
+   osal_id_t        MutexId;
+   CFE_ES_TaskId_t  ChildTaskId;
+   bool             ChildTaskReady;
+
+   /*
+   ** Test Definition
+   */
+
+   uint16  RateStep;
+   uint16  MaxRate;
+   uint16  StepCycles;
+   uint16  PipeDepth;
+
+   /*
+   ** Class State Data
+   */
+
+   bool    Active;
+   bool    FirstCycle;
+   bool    Settling;
+   uint16  Step;
+   uint16  CycleCnt;
+
+   uint16  PrevValidCmdCnt;
+   uint16  PrevInvalidCmdCnt;
+
+   uint32  ValidRcvd;
+   uint32  InvalidRcvd;
+
+   CFE_TIME_SysTime_t  PrevTickTime;
+   uint16  TickCnt;
+   uint16  TickLateCnt;
+   uint32  TickIntervalMaxMs;
+   uint32  TickIntervalSumMs;
+
+   /*
+   ** Data shared with the child task, protected by MutexId
+   */
+
+   bool    Sending;
+   uint16  StepSeq;
+   uint16  Rate;
+   uint16  BurstLen;
+   uint8   InvalidPct;
+   CFE_SB_MsgId_t CmdMid;
+
+   uint32  ValidSent;
+   uint32  InvalidSent;
+
+   /*
+   ** Messages
+   */
+
+   PL_SIM_Noop_t        ValidCmd;    /* Child task only */
+   PL_SIM_Noop_t        InvalidCmd;  /* Child task only */
+   PL_SIM_LoadGenTlm_t  Tlm;
+
+} LOAD_GEN_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LOAD_GEN_Constructor
+**
+** Initialize the load generator to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function and only once
+**      because it creates the child task.
+**   2. PipeDepth is only used to identify the pipe configuration in
+**      telemetry.
+**   3. Tests are rejected if the child task can't be created.
+**
+*/
+void LOAD_GEN_Constructor(LOAD_GEN_Class_t *LoadGenPtr, CFE_SB_MsgId_t CmdMid,
+                          CFE_SB_MsgId_t TlmMid, uint16 PipeDepth);
+
+
+/******************************************************************************
+** Function: LOAD_GEN_SetConfig
+**
+** Change the command MID, telemetry MID and pipe depth. An active test is
+** stopped.
+**
+*/
+void LOAD_GEN_SetConfig(CFE_SB_MsgId_t CmdMid, CFE_SB_MsgId_t TlmMid, uint16 PipeDepth);
+
+
+/******************************************************************************
+** Function: LOAD_GEN_Execute
+**
+** Perform one execution cycle of an active test.
+**
+** Notes:
+**  1. Must be called once per execution cycle with the current command
+**     manager counters.
+**
+*/
+void LOAD_GEN_Execute(uint16 ValidCmdCnt, uint16 InvalidCmdCnt);
+
+
+/******************************************************************************
+** Function: LOAD_GEN_StartCmd
+**
+** Start a rate sweep test.
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**
+*/
+bool LOAD_GEN_StartCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: LOAD_GEN_StopCmd
+**
+** Stop the current test and send telemetry for the partial step.
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**
+*/
+bool LOAD_GEN_StopCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _load_gen_ */
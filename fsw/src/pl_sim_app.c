@@ -28,6 +28,7 @@
 ** Includes
 */
 
+#include <stdio.h>
 #include <string.h>
 #include "pl_sim_app.h"
 #include "pl_sim_eds_cc.h"
@@ -37,17 +38,32 @@
 /***********************/
 
 /* Convenience macros */
-#define  INITBL_OBJ    (&(PlSim.IniTbl))
-#define  CMDMGR_OBJ    (&(PlSim.CmdMgr))
+#define  INITBL_OBJ      (&(PlSim.IniTbl))
+#define  CMDMGR_OBJ      (&(PlSim.CmdMgr))
+#define  EVT_LOG_OBJ     (&(PlSim.EvtLog))
+#define  LOAD_GEN_OBJ    (&(PlSim.LoadGen))
+#define  TLM_SHAPER_OBJ  (&(PlSim.TlmShaper))
+#define  IMG_STATS_OBJ   (&(PlSim.ImgStats))
 
 
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
+static int32 CreateCmdPipe(const PL_SIM_Config_t *Config, CFE_SB_PipeId_t *PipeId);
 static int32 InitApp(void);
+static bool IsCmdFuncCode(uint16 FuncCode);
+static bool LoadConfig(PL_SIM_Config_t *Config);
 static int32 ProcessCommands(void);
+static bool ReadIniParam(PL_SIM_CfgParam_t *Param, uint16 ParamId, const char *ParamName,
+                         const char *TypeStr);
+static bool ReadIniTbl(PL_SIM_Config_t *Config);
+static bool ReloadCfg(void);
+static void ReloadCfgAppendChange(char *ChangeStr, const char *ParamName);
+static int32 ReloadCmdPipe(const PL_SIM_Config_t *NewCfg, bool *PipeLost);
+static int32 ReloadSubscriptions(CFE_SB_MsgId_t NewCmdMid, CFE_SB_MsgId_t NewExecuteMid);
 static void SendStatusTlm(void);
+static bool ValidateConfig(const PL_SIM_Config_t *Config);
 
 
 /**********************/
@@ -60,6 +76,63 @@ static void SendStatusTlm(void);
 */
 DEFINE_ENUM(Config,APP_CONFIG)  
 
+/*
+** Configuration schema used to identify the cached configuration layout.
+** Each APP_CONFIG entry is stringified as "NAME:type;".
+*/
+#define PL_SIM_CFG_SCHEMA_STR(Name, Type)  #Name ":" #Type ";"
+static const char CfgSchema[] = APP_CONFIG(PL_SIM_CFG_SCHEMA_STR);
+
+
+/*
+** Commands handled by the app. Each entry names the EDS function code and
+** command type without their PL_SIM_ prefix and suffixes, the object data
+** and the command function. The dispatch table, the payload lengths and
+** IsCmdFuncCode() are generated from this list so:
+**   - A command renamed or removed in pl_sim.xml is a build error
+**   - Two commands with the same function code are a build error (duplicate
+**     case label in IsCmdFuncCode())
+**   - Payload lengths always match the EDS command types
+** A command added to pl_sim.xml without an entry is not detected at build
+** time. The command manager rejects its function code at runtime.
+*/
+#define PL_SIM_CMD_LIST(XX) \
+   XX(NOOP,           Noop,         NULL,         PL_SIM_NoOpCmd)       \
+   XX(RESET,          Reset,        NULL,         PL_SIM_ResetAppCmd)   \
+   XX(POWER_ON,       PowerOn,      &PlSim,       PL_SIM_PowerOnCmd)    \
+   XX(POWER_OFF,      PowerOff,     &PlSim,       PL_SIM_PowerOffCmd)   \
+   XX(SET_FAULT,      SetFault,     &PlSim,       PL_SIM_SetFaultCmd)   \
+   XX(CLEAR_FAULT,    ClearFault,   &PlSim,       PL_SIM_ClearFaultCmd) \
+   XX(DUMP_EVT_LOG,   DumpEvtLog,   EVT_LOG_OBJ,  EVT_LOG_DumpCmd)      \
+   XX(START_LOAD_GEN, StartLoadGen, LOAD_GEN_OBJ, LOAD_GEN_StartCmd)    \
+   XX(STOP_LOAD_GEN,  StopLoadGen,  LOAD_GEN_OBJ, LOAD_GEN_StopCmd)     \
+   XX(RELOAD_CFG,     ReloadCfg,    &PlSim,       PL_SIM_ReloadCfgCmd)
+
+#define PL_SIM_CMD_PAYLOAD_LEN(CmdType)  (sizeof(CmdType) - sizeof(CFE_MSG_CommandHeader_t))
+
+typedef struct
+{
+
+   void                 *ObjDataPtr;
+   CMDMGR_CmdFuncPtr_t   FuncPtr;
+   uint16                UserDataLen;
+
+} PL_SIM_CmdTblEntry_t;
+
+#define PL_SIM_CMD_TBL_ENTRY(Cc, Type, ObjDataPtr, FuncPtr) \
+   [PL_SIM_##Cc##_CC] = { ObjDataPtr, FuncPtr, PL_SIM_CMD_PAYLOAD_LEN(PL_SIM_##Type##_t) },
+
+static const PL_SIM_CmdTblEntry_t CmdTbl[] =
+{
+
+   PL_SIM_CMD_LIST(PL_SIM_CMD_TBL_ENTRY)
+
+};
+
+#define PL_SIM_CMD_TBL_LEN  (sizeof(CmdTbl)/sizeof(CmdTbl[0]))
+
+CompileTimeAssert(LOAD_GEN_INVALID_CMD_FC >= PL_SIM_CMD_TBL_LEN, LoadGenInvalidFcIsRegistered);
+
 
 /*****************/
 /** Global Data **/
@@ -122,8 +195,8 @@ bool PL_SIM_ClearFaultCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
    
    PL_SIM_LIB_ClearFault();
 
-   CFE_EVS_SendEvent (PL_SIM_CLEAR_FAULT_CMD_EID, CFE_EVS_EventType_INFORMATION, 
-                      "Payload fault set to FALSE.");
+   EVT_LOG_Write(PL_SIM_CLEAR_FAULT_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                 "Payload fault set to FALSE.", 0);
                
    return true;
 
@@ -137,9 +210,9 @@ bool PL_SIM_ClearFaultCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 bool PL_SIM_NoOpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
-   CFE_EVS_SendEvent (PL_SIM_NOOP_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                      "No operation command received for PL_SIM App version %d.%d.%d",
-                      PL_SIM_MAJOR_VER, PL_SIM_MINOR_VER, PL_SIM_PLATFORM_REV);
+   EVT_LOG_Write(PL_SIM_NOOP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                 "No operation command received for PL_SIM App version %d.%d.%d", 3,
+                 PL_SIM_MAJOR_VER, PL_SIM_MINOR_VER, PL_SIM_PLATFORM_REV);
 
    return true;
 
@@ -157,11 +230,21 @@ bool PL_SIM_NoOpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 ** Note:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
 **  2. The PL_SIM library outputs an event message power state transitions
+**  3. The library state is read after the command so the logged power state
+**     transition is current. Power states are logged as their enumeration
+**     values because the event log only stores integer arguments.
 */
 bool PL_SIM_PowerOffCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   int32 PrevPower = PlSim.Lib.State.Power;
+   
    PL_SIM_LIB_PowerOff();
+   PL_SIM_LIB_ReadState(&PlSim.Lib);
+
+   EVT_LOG_Write(PL_SIM_PWR_OFF_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                 "Power off payload cmd accepted. Power state changed from %d to %d.", 2,
+                 PrevPower, PlSim.Lib.State.Power);
       
    return true;
 
@@ -176,15 +259,23 @@ bool PL_SIM_PowerOffCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 ** Note:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
 **  2. The PL_SIM_LIB outputs an event message power state transitions
+**  3. The accepted path is logged like PL_SIM_PowerOffCmd(). The rejection
+**     is sent directly to EVS so it can include the power state name.
 */
 bool PL_SIM_PowerOnCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtrr)
 {
 
-   bool RetStatus = false;
+   bool  RetStatus = false;
+   int32 PrevPower = PlSim.Lib.State.Power;
 
    if (PlSim.Lib.State.Power == PL_SIM_LIB_Power_OFF)
    {
       PL_SIM_LIB_PowerOn();      
+      PL_SIM_LIB_ReadState(&PlSim.Lib);
+
+      EVT_LOG_Write(PL_SIM_PWR_ON_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                    "Power on payload cmd accepted. Power state changed from %d to %d.", 2,
+                    PrevPower, PlSim.Lib.State.Power);
       RetStatus = true;
    
    }  
@@ -200,6 +291,26 @@ bool PL_SIM_PowerOnCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtrr)
 } /* End PL_SIM_PowerOnCmd() */
 
 
+/******************************************************************************
+** Function: PL_SIM_ReloadCfgCmd
+**
+** Notes:
+**   1. The reload is performed by ReloadCfg() at the start of the next
+**      execution cycle so changes are applied between cycles.
+*/
+bool PL_SIM_ReloadCfgCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   PlSim.ReloadCfgPending = true;
+   
+   EVT_LOG_Write(PL_SIM_RELOAD_CFG_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                 "Configuration reload will be performed at the next execution cycle", 0);
+   
+   return true;
+
+} /* End PL_SIM_ReloadCfgCmd() */
+
+
 /******************************************************************************
 ** Function: PL_SIM_ResetAppCmd
 **
@@ -212,6 +323,8 @@ bool PL_SIM_ResetAppCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
    CMDMGR_ResetStatus(CMDMGR_OBJ);
+   EVT_LOG_ResetStatus();
+   TLM_SHAPER_ResetStatus();
    
    /* Leave the PL_SIM library state intact */
 	  
@@ -233,14 +346,76 @@ bool PL_SIM_SetFaultCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
    
    PL_SIM_LIB_SetFault();
 
-   CFE_EVS_SendEvent (PL_SIM_SET_FAULT_CMD_EID, CFE_EVS_EventType_INFORMATION, 
-                      "Payload fault set to TRUE.");
+   EVT_LOG_Write(PL_SIM_SET_FAULT_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                 "Payload fault set to TRUE.", 0);
                
    return true;
 
 } /* End PL_SIM_SetFaultCmd() */
 
 
+/******************************************************************************
+** Function: CreateCmdPipe
+**
+** Create a command pipe and subscribe to the command and execute MIDs
+** defined in Config.
+**
+** Notes:
+**   1. The pipe is deleted if a subscription fails so nothing is left
+**      behind on an error. An event identifies the call that failed.
+*/
+static int32 CreateCmdPipe(const PL_SIM_Config_t *Config, CFE_SB_PipeId_t *PipeId)
+{
+
+   int32  SysStatus;
+   CFE_SB_MsgId_t CmdMid     = CFE_SB_ValueToMsgId(Config->CFG_PL_SIM_CMD_TOPICID.Int);
+   CFE_SB_MsgId_t ExecuteMid = CFE_SB_ValueToMsgId(Config->CFG_BC_SCH_1_HZ_TOPICID.Int);
+
+
+   SysStatus = CFE_SB_CreatePipe(PipeId, Config->CFG_CMD_PIPE_DEPTH.Int, Config->CFG_CMD_PIPE_NAME.Str);
+
+   if (SysStatus == CFE_SUCCESS)
+   {
+
+      SysStatus = CFE_SB_Subscribe(CmdMid, *PipeId);
+      if (SysStatus == CFE_SUCCESS)
+      {
+         SysStatus = CFE_SB_Subscribe(ExecuteMid, *PipeId);
+         if (SysStatus != CFE_SUCCESS)
+         {
+            CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Failed to subscribe to execute MID 0x%04X on pipe %s, status = 0x%08X",
+                              (unsigned int)CFE_SB_MsgIdToValue(ExecuteMid), Config->CFG_CMD_PIPE_NAME.Str,
+                              (unsigned int)SysStatus);
+         }
+      }
+      else
+      {
+         CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Failed to subscribe to command MID 0x%04X on pipe %s, status = 0x%08X",
+                           (unsigned int)CFE_SB_MsgIdToValue(CmdMid), Config->CFG_CMD_PIPE_NAME.Str,
+                           (unsigned int)SysStatus);
+      }
+
+      if (SysStatus != CFE_SUCCESS)
+      {
+         CFE_SB_DeletePipe(*PipeId);
+      }
+
+   } /* End if pipe created */
+   else
+   {
+      CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to create command pipe %s with depth %d, status = 0x%08X",
+                        Config->CFG_CMD_PIPE_NAME.Str, (int)Config->CFG_CMD_PIPE_DEPTH.Int,
+                        (unsigned int)SysStatus);
+   }
+
+   return SysStatus;
+
+} /* End CreateCmdPipe() */
+
+
 /******************************************************************************
 ** Function: InitApp
 **
@@ -248,22 +423,27 @@ bool PL_SIM_SetFaultCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 static int32 InitApp(void)
 {
 
-   int32 Status = APP_C_FW_CFS_ERROR;
+   int32  Status = APP_C_FW_CFS_ERROR;
+   uint16 i;
    
    /*
    ** Initialize objects 
    */
 
-   if (INITBL_Constructor(&PlSim.IniTbl, PL_SIM_INI_FILENAME, &IniCfgEnum))
+   if (LoadConfig(&PlSim.Config))
    {
    
-      PlSim.CmdMid      = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_PL_SIM_CMD_TOPICID));
-      PlSim.ExecuteMid  = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC_SCH_1_HZ_TOPICID));
-      PlSim.TlmSlowRate = INITBL_GetIntConfig(INITBL_OBJ, CFG_TLM_SLOW_RATE);
+      PlSim.CmdMid      = CFE_SB_ValueToMsgId(PlSim.Config.CFG_PL_SIM_CMD_TOPICID.Int);
+      PlSim.ExecuteMid  = CFE_SB_ValueToMsgId(PlSim.Config.CFG_BC_SCH_1_HZ_TOPICID.Int);
+      PlSim.TlmSlowRate = PlSim.Config.CFG_TLM_SLOW_RATE.Int;
 
-      Status = CFE_SUCCESS; 
+      /* The event log is constructed first so other objects can write to it */
+      if (EVT_LOG_Constructor(EVT_LOG_OBJ, PlSim.Config.CFG_EVT_LOG_FLUSH_LIM.Int))
+      {
+         Status = CFE_SUCCESS; 
+      }
   
-   } /* End if INITBL Constructed */
+   } /* End if configuration loaded */
   
    if (Status == CFE_SUCCESS)
    {
@@ -272,38 +452,52 @@ static int32 InitApp(void)
       ** Constuct app's child objects
       */
             
+      LOAD_GEN_Constructor(LOAD_GEN_OBJ, PlSim.CmdMid,
+                           CFE_SB_ValueToMsgId(PlSim.Config.CFG_PL_SIM_LOAD_GEN_TLM_TOPICID.Int),
+                           PlSim.Config.CFG_CMD_PIPE_DEPTH.Int);
+      
+      TLM_SHAPER_Constructor(TLM_SHAPER_OBJ);
+      TLM_SHAPER_SetRate(TLM_SHAPER_STATUS,
+                         PlSim.Config.CFG_TLM_SHAPER_STATUS_BYTES_PER_SEC.Int,
+                         PlSim.Config.CFG_TLM_SHAPER_STATUS_BURST_BYTES.Int);
+      TLM_SHAPER_SetRate(TLM_SHAPER_SCIENCE,
+                         PlSim.Config.CFG_TLM_SHAPER_SCIENCE_BYTES_PER_SEC.Int,
+                         PlSim.Config.CFG_TLM_SHAPER_SCIENCE_BURST_BYTES.Int);
+      
+      IMG_STATS_Constructor(IMG_STATS_OBJ, CFE_SB_ValueToMsgId(PlSim.Config.CFG_PL_SIM_IMAGE_SUMMARY_TLM_TOPICID.Int));
         
       /*
       ** Initialize app level interfaces
       */
       
-      CFE_SB_CreatePipe(&PlSim.CmdPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_CMD_PIPE_DEPTH), INITBL_GetStrConfig(INITBL_OBJ, CFG_CMD_PIPE_NAME));  
-      CFE_SB_Subscribe(PlSim.CmdMid,     PlSim.CmdPipe);
-      CFE_SB_Subscribe(PlSim.ExecuteMid, PlSim.CmdPipe);
+      Status = CreateCmdPipe(&PlSim.Config, &PlSim.CmdPipe);
 
       CMDMGR_Constructor(CMDMGR_OBJ);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_NOOP_CC,  NULL, PL_SIM_NoOpCmd,     0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_RESET_CC, NULL, PL_SIM_ResetAppCmd, 0);
-
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_POWER_ON_CC,    &PlSim,  PL_SIM_PowerOnCmd,    0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_POWER_OFF_CC,   &PlSim,  PL_SIM_PowerOffCmd,   0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_SET_FAULT_CC,   &PlSim,  PL_SIM_SetFaultCmd,   0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_SIM_CLEAR_FAULT_CC, &PlSim,  PL_SIM_ClearFaultCmd, 0);
+      for (i=0; i < PL_SIM_CMD_TBL_LEN; i++)
+      {
+         if (IsCmdFuncCode(i))
+         {
+            CMDMGR_RegisterFunc(CMDMGR_OBJ, i, CmdTbl[i].ObjDataPtr, CmdTbl[i].FuncPtr, CmdTbl[i].UserDataLen);
+         }
+      }
 
       /*
       ** Initialize app messages 
       */
  
       CFE_MSG_Init(CFE_MSG_PTR(PlSim.StatusTlm.TelemetryHeader), 
-                   CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_PL_SIM_STATUS_TLM_TOPICID)), 
+                   CFE_SB_ValueToMsgId(PlSim.Config.CFG_PL_SIM_STATUS_TLM_TOPICID.Int), 
                    sizeof(PL_SIM_StatusTlm_t));
 
       /*
       ** Application startup event message
       */
-      CFE_EVS_SendEvent(PL_SIM_INIT_APP_EID, CFE_EVS_EventType_INFORMATION,
-                        "PL_SIM App Initialized. Version %d.%d.%d",
-                        PL_SIM_MAJOR_VER, PL_SIM_MINOR_VER, PL_SIM_PLATFORM_REV);
+      if (Status == CFE_SUCCESS)
+      {
+         CFE_EVS_SendEvent(PL_SIM_INIT_APP_EID, CFE_EVS_EventType_INFORMATION,
+                           "PL_SIM App Initialized. Version %d.%d.%d",
+                           PL_SIM_MAJOR_VER, PL_SIM_MINOR_VER, PL_SIM_PLATFORM_REV);
+      }
                         
    } /* End if CHILDMGR constructed */
    
@@ -312,6 +506,93 @@ static int32 InitApp(void)
 } /* End of InitApp() */
 
 
+/******************************************************************************
+** Function: IsCmdFuncCode
+**
+** Return true if FuncCode has an entry in the command table.
+**
+** Notes:
+**   1. The switch is generated from PL_SIM_CMD_LIST so two commands with
+**      the same function code are a duplicate case label build error.
+*/
+static bool IsCmdFuncCode(uint16 FuncCode)
+{
+
+   bool RetStatus;
+
+#define PL_SIM_CMD_CASE(Cc, Type, ObjDataPtr, FuncPtr)  case PL_SIM_##Cc##_CC:
+   switch (FuncCode)
+   {
+      PL_SIM_CMD_LIST(PL_SIM_CMD_CASE)
+         RetStatus = true;
+         break;
+      default:
+         RetStatus = false;
+         break;
+   }
+#undef PL_SIM_CMD_CASE
+
+   return RetStatus;
+
+} /* End IsCmdFuncCode() */
+
+
+/******************************************************************************
+** Function: LoadConfig
+**
+** Load the configuration from the binary cache file if it was created from
+** the current JSON init file, otherwise parse the JSON file and rewrite the
+** cache.
+**
+** Notes:
+**   1. A cache write failure doesn't prevent the app from starting.
+**   2. An invalid configuration is never written to the cache.
+**   3. The cache isn't used after a mission rebuild or on a different
+**      platform because the resolved topic IDs may have changed. See
+**      cfg_cache.h.
+*/
+static bool LoadConfig(PL_SIM_Config_t *Config)
+{
+
+   bool   RetStatus = false;
+   bool   SrcCrcValid;
+   uint32 SrcCrc;
+   uint32 SrcSize;
+   uint32 SchemaCrc;
+
+
+   SrcCrcValid = CFG_CACHE_ComputeFileCrc(PL_SIM_INI_FILENAME, &SrcCrc, &SrcSize);
+   SchemaCrc   = CFG_CACHE_CalculateCrc(CfgSchema, sizeof(CfgSchema), 0);
+
+   if (SrcCrcValid && CFG_CACHE_Read(PL_SIM_INI_CACHE_FILENAME, SrcCrc, SrcSize, SchemaCrc,
+                                     Config, sizeof(PL_SIM_Config_t)))
+   {
+   
+      RetStatus = ValidateConfig(Config);
+      
+   }
+   else if (INITBL_Constructor(INITBL_OBJ, PL_SIM_INI_FILENAME, &IniCfgEnum))
+   {
+   
+      if (ReadIniTbl(Config) && ValidateConfig(Config))
+      {
+         
+         if (SrcCrcValid)
+         {
+            CFG_CACHE_Write(PL_SIM_INI_CACHE_FILENAME, SrcCrc, SrcSize, SchemaCrc,
+                            Config, sizeof(PL_SIM_Config_t));
+         }
+      
+         RetStatus = true;
+      
+      }
+   }
+   
+   return RetStatus;
+
+} /* End LoadConfig() */
+
+
 /******************************************************************************
 ** Function: ProcessCommands
 **
@@ -345,9 +626,24 @@ static int32 ProcessCommands(void)
          else if (CFE_SB_MsgId_Equal(MsgId, PlSim.ExecuteMid))
          {
 
-
+            /* SbBufPtr must not be used after a reload because the pipe may be recreated */
+            if (PlSim.ReloadCfgPending)
+            {
+               PlSim.ReloadCfgPending = false;
+               if (!ReloadCfg())
+               {
+                  RetStatus = CFE_ES_RunStatus_APP_ERROR;
+               }
+            }
+            
+            TLM_SHAPER_Execute();
+            
             PL_SIM_LIB_ExecuteStep();
             PL_SIM_LIB_ReadState(&PlSim.Lib);
+            IMG_STATS_Execute(PlSim.Lib.State.Power != PL_SIM_LIB_Power_OFF &&
+                              !PlSim.Lib.State.DetectorFaultPresent,
+                              PlSim.Lib.Detector.ImageCnt, PlSim.Lib.Detector.ReadoutRow,
+                              (const uint8*)PlSim.Lib.Detector.Row.Data, PL_SIM_LIB_DETECTOR_ROW_LEN);
             if (PlSim.Lib.State.Power != PL_SIM_LIB_Power_OFF)
             {
                SendStatusTlm();
@@ -364,21 +660,25 @@ static int32 ProcessCommands(void)
                   PlSim.TlmSlowRateCnt++;
                }
             }
+            
+            LOAD_GEN_Execute(PlSim.CmdMgr.ValidCmdCnt, PlSim.CmdMgr.InvalidCmdCnt);
+            EVT_LOG_Flush();
+            
          }
          else
          {
             
-            CFE_EVS_SendEvent(PL_SIM_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
-                              "Received invalid command packet, MID = 0x%04X",
-                              CFE_SB_MsgIdToValue(MsgId));
+            EVT_LOG_Write(PL_SIM_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
+                          "Received invalid command packet, MID = 0x%04X", 1,
+                          (int32)CFE_SB_MsgIdToValue(MsgId));
          } 
 
       }
       else
       {
          
-         CFE_EVS_SendEvent(PL_SIM_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "CFE couldn't retrieve message ID from the message, Status = %d", SysStatus);
+         EVT_LOG_Write(PL_SIM_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
+                       "CFE couldn't retrieve message ID from the message, Status = %d", 1, SysStatus);
       }
       
    } /* Valid SB receive */ 
@@ -394,6 +694,364 @@ static int32 ProcessCommands(void)
 } /* End ProcessCommands() */
 
 
+/******************************************************************************
+** Function: ReadIniTbl
+**
+** Copy the parsed JSON init file values into a configuration structure.
+**
+** Notes:
+**   1. The structure is cleared first so the cached binary image doesn't
+**      depend on uninitialized union or string bytes.
+**   2. The copy is generated from APP_CONFIG so a new parameter only needs
+**      to be added to app_cfg.h and the init file.
+**   3. Returns false if any parameter couldn't be copied.
+*/
+static bool ReadIniTbl(PL_SIM_Config_t *Config)
+{
+
+   bool RetStatus = true;
+   
+   CFE_PSP_MemSet((void*)Config, 0, sizeof(PL_SIM_Config_t));
+   
+#define PL_SIM_CFG_READ(Name, Type)  RetStatus &= ReadIniParam(&Config->Name, Name, #Name, #Type);
+   APP_CONFIG(PL_SIM_CFG_READ)
+#undef PL_SIM_CFG_READ
+
+   return RetStatus;
+   
+} /* End ReadIniTbl() */
+
+
+/******************************************************************************
+** Function: ReadIniParam
+**
+** Copy one parsed JSON init file value using the type name from APP_CONFIG.
+**
+** Notes:
+**   1. Strings that don't fit in the parameter are rejected rather than
+**      truncated since a truncated pipe name would be silently accepted.
+*/
+static bool ReadIniParam(PL_SIM_CfgParam_t *Param, uint16 ParamId, const char *ParamName,
+                         const char *TypeStr)
+{
+
+   bool RetStatus = true;
+   const char *Str;
+   
+   if (strcmp(TypeStr, PL_SIM_CFG_STR_TYPE) == 0)
+   {
+      Str = INITBL_GetStrConfig(INITBL_OBJ, ParamId);
+      if (strlen(Str) < sizeof(Param->Str))
+      {
+         strncpy(Param->Str, Str, sizeof(Param->Str) - 1);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(PL_SIM_CONFIG_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Init file parameter %s exceeds %d characters",
+                           ParamName, (int)(sizeof(Param->Str) - 1));
+         RetStatus = false;
+      }
+   }
+   else
+   {
+      Param->Int = INITBL_GetIntConfig(INITBL_OBJ, ParamId);
+   }
+
+   return RetStatus;
+   
+} /* End ReadIniParam() */
+
+
+/******************************************************************************
+** Function: ReloadCfg
+**
+** Reload the configuration and apply the parameters that changed.
+**
+** Notes:
+**   1. The new configuration is validated before anything is changed. If
+**      the init file can't be loaded or an SB call fails the current
+**      configuration, pipe and subscriptions are retained and an event
+**      identifies the failure.
+**   2. PlSim.Config and the MIDs are only updated after every SB call has
+**      succeeded so the remaining parameters can't fail to apply.
+**   3. Returns false only if the command pipe was lost and couldn't be
+**      restored since the app can't continue without it.
+**   4. Messages queued in the old pipe are discarded when it's replaced.
+**   5. Changing the load generator's parameters stops an active test.
+*/
+static bool ReloadCfg(void)
+{
+
+   bool    PipeLost = false;
+   int32   SysStatus;
+   uint16  ChangeCnt = 0;
+   char    ChangeStr[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+   PL_SIM_Config_t  NewCfg;
+   PL_SIM_Config_t *OldCfg = &PlSim.Config;
+   CFE_SB_MsgId_t   NewCmdMid;
+   CFE_SB_MsgId_t   NewExecuteMid;
+   
+   
+   if (!LoadConfig(&NewCfg))
+   {
+      CFE_EVS_SendEvent(PL_SIM_RELOAD_CFG_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Configuration reload failed, unable to load a valid configuration from %s. Current configuration retained.",
+                        PL_SIM_INI_FILENAME);
+      return true;
+   }
+   
+   NewCmdMid     = CFE_SB_ValueToMsgId(NewCfg.CFG_PL_SIM_CMD_TOPICID.Int);
+   NewExecuteMid = CFE_SB_ValueToMsgId(NewCfg.CFG_BC_SCH_1_HZ_TOPICID.Int);
+   
+   /*
+   ** Command pipe and subscriptions
+   */
+   
+   if (NewCfg.CFG_CMD_PIPE_DEPTH.Int != OldCfg->CFG_CMD_PIPE_DEPTH.Int ||
+       strcmp(NewCfg.CFG_CMD_PIPE_NAME.Str, OldCfg->CFG_CMD_PIPE_NAME.Str) != 0)
+   {
+      SysStatus = ReloadCmdPipe(&NewCfg, &PipeLost);
+   }
+   else
+   {
+      SysStatus = ReloadSubscriptions(NewCmdMid, NewExecuteMid);
+   }
+
+   if (SysStatus != CFE_SUCCESS)
+   {
+      if (PipeLost)
+      {
+         CFE_ES_WriteToSysLog("PL_SIM lost command pipe %s during configuration reload. Status = 0x%08X\n",
+                              OldCfg->CFG_CMD_PIPE_NAME.Str, (unsigned int)SysStatus);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(PL_SIM_RELOAD_CFG_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Configuration reload failed updating the command pipe, status = 0x%08X. Current configuration retained.",
+                           (unsigned int)SysStatus);
+      }
+      return !PipeLost;
+   }
+   
+   PlSim.CmdMid     = NewCmdMid;
+   PlSim.ExecuteMid = NewExecuteMid;
+
+   /*
+   ** Telemetry
+   */
+   
+   if (NewCfg.CFG_PL_SIM_STATUS_TLM_TOPICID.Int != OldCfg->CFG_PL_SIM_STATUS_TLM_TOPICID.Int)
+   {
+      CFE_MSG_Init(CFE_MSG_PTR(PlSim.StatusTlm.TelemetryHeader), 
+                   CFE_SB_ValueToMsgId(NewCfg.CFG_PL_SIM_STATUS_TLM_TOPICID.Int), 
+                   sizeof(PL_SIM_StatusTlm_t));
+   }
+   
+   if (NewCfg.CFG_PL_SIM_IMAGE_SUMMARY_TLM_TOPICID.Int != OldCfg->CFG_PL_SIM_IMAGE_SUMMARY_TLM_TOPICID.Int)
+   {
+      CFE_MSG_Init(CFE_MSG_PTR(PlSim.ImgStats.Tlm.TelemetryHeader), 
+                   CFE_SB_ValueToMsgId(NewCfg.CFG_PL_SIM_IMAGE_SUMMARY_TLM_TOPICID.Int), 
+                   sizeof(PL_SIM_ImageSummaryTlm_t));
+   }
+   
+   PlSim.TlmSlowRate = NewCfg.CFG_TLM_SLOW_RATE.Int;
+
+   /*
+   ** App Objects
+   */
+   
+   EVT_LOG_SetFlushLim(NewCfg.CFG_EVT_LOG_FLUSH_LIM.Int);
+
+   if (NewCfg.CFG_PL_SIM_LOAD_GEN_TLM_TOPICID.Int != OldCfg->CFG_PL_SIM_LOAD_GEN_TLM_TOPICID.Int ||
+       NewCfg.CFG_PL_SIM_CMD_TOPICID.Int != OldCfg->CFG_PL_SIM_CMD_TOPICID.Int ||
+       NewCfg.CFG_CMD_PIPE_DEPTH.Int     != OldCfg->CFG_CMD_PIPE_DEPTH.Int)
+   {
+      LOAD_GEN_SetConfig(PlSim.CmdMid, CFE_SB_ValueToMsgId(NewCfg.CFG_PL_SIM_LOAD_GEN_TLM_TOPICID.Int),
+                         NewCfg.CFG_CMD_PIPE_DEPTH.Int);
+   }
+   
+   if (NewCfg.CFG_TLM_SHAPER_STATUS_BYTES_PER_SEC.Int != OldCfg->CFG_TLM_SHAPER_STATUS_BYTES_PER_SEC.Int ||
+       NewCfg.CFG_TLM_SHAPER_STATUS_BURST_BYTES.Int  != OldCfg->CFG_TLM_SHAPER_STATUS_BURST_BYTES.Int)
+   {
+      TLM_SHAPER_SetRate(TLM_SHAPER_STATUS, NewCfg.CFG_TLM_SHAPER_STATUS_BYTES_PER_SEC.Int,
+                         NewCfg.CFG_TLM_SHAPER_STATUS_BURST_BYTES.Int);
+   }
+   if (NewCfg.CFG_TLM_SHAPER_SCIENCE_BYTES_PER_SEC.Int != OldCfg->CFG_TLM_SHAPER_SCIENCE_BYTES_PER_SEC.Int ||
+       NewCfg.CFG_TLM_SHAPER_SCIENCE_BURST_BYTES.Int  != OldCfg->CFG_TLM_SHAPER_SCIENCE_BURST_BYTES.Int)
+   {
+      TLM_SHAPER_SetRate(TLM_SHAPER_SCIENCE, NewCfg.CFG_TLM_SHAPER_SCIENCE_BYTES_PER_SEC.Int,
+                         NewCfg.CFG_TLM_SHAPER_SCIENCE_BURST_BYTES.Int);
+   }
+
+   /*
+   ** Report the changed parameters. APP_CFE_NAME only takes effect after
+   ** the app is restarted.
+   */
+   
+   ChangeStr[0] = '\0';
+#define PL_SIM_CFG_CHANGED(Name, Type)                                          \
+   if (memcmp(&NewCfg.Name, &OldCfg->Name, sizeof(PL_SIM_CfgParam_t)) != 0)    \
+   {                                                                            \
+      ReloadCfgAppendChange(ChangeStr, #Name);                                  \
+      ChangeCnt++;                                                              \
+   }
+   APP_CONFIG(PL_SIM_CFG_CHANGED)
+#undef PL_SIM_CFG_CHANGED
+
+   if (strcmp(NewCfg.CFG_APP_CFE_NAME.Str, OldCfg->CFG_APP_CFE_NAME.Str) != 0)
+   {
+      ReloadCfgAppendChange(ChangeStr, "(restart required)");
+   }
+
+   PlSim.Config = NewCfg;
+   
+   CFE_EVS_SendEvent(PL_SIM_RELOAD_CFG_EID, CFE_EVS_EventType_INFORMATION,
+                     "Configuration reloaded, %d changes:%s", ChangeCnt, ChangeStr);
+   
+   return true;
+
+} /* End ReloadCfg() */
+
+
+/******************************************************************************
+** Function: ReloadCfgAppendChange
+**
+** Append a parameter name to the reload summary, truncating the summary if
+** it exceeds the event message length.
+*/
+static void ReloadCfgAppendChange(char *ChangeStr, const char *ParamName)
+{
+
+   size_t StrLen = strlen(ChangeStr);
+   
+   snprintf(&ChangeStr[StrLen], CFE_MISSION_EVS_MAX_MESSAGE_LENGTH - StrLen, " %s", ParamName);
+
+} /* End ReloadCfgAppendChange() */
+
+
+/******************************************************************************
+** Function: ReloadCmdPipe
+**
+** Replace the command pipe with one created from NewCfg.
+**
+** Notes:
+**   1. When the pipe name changes the new pipe is created before the old
+**      one is deleted so a failure leaves the old pipe untouched.
+**   2. SB pipe names must be unique so when only the depth changes the old
+**      pipe is deleted first and recreated from the current configuration
+**      if the new pipe can't be created. PipeLost is set if that fails.
+**   3. Returns the status of the call that failed creating the new pipe.
+*/
+static int32 ReloadCmdPipe(const PL_SIM_Config_t *NewCfg, bool *PipeLost)
+{
+
+   int32  SysStatus;
+   CFE_SB_PipeId_t NewPipe;
+
+   *PipeLost = false;
+   
+   if (strcmp(NewCfg->CFG_CMD_PIPE_NAME.Str, PlSim.Config.CFG_CMD_PIPE_NAME.Str) != 0)
+   {
+      
+      SysStatus = CreateCmdPipe(NewCfg, &NewPipe);
+      if (SysStatus == CFE_SUCCESS)
+      {
+         CFE_SB_DeletePipe(PlSim.CmdPipe);
+         PlSim.CmdPipe = NewPipe;
+      }
+      
+   }
+   else
+   {
+      
+      CFE_SB_DeletePipe(PlSim.CmdPipe);
+      SysStatus = CreateCmdPipe(NewCfg, &PlSim.CmdPipe);
+      if (SysStatus != CFE_SUCCESS)
+      {
+         *PipeLost = (CreateCmdPipe(&PlSim.Config, &PlSim.CmdPipe) != CFE_SUCCESS);
+      }
+      
+   }
+   
+   return SysStatus;
+   
+} /* End ReloadCmdPipe() */
+
+
+/******************************************************************************
+** Function: ReloadSubscriptions
+**
+** Move the command and execute subscriptions on the current pipe to new
+** MIDs.
+**
+** Notes:
+**   1. New MIDs are subscribed before the current ones are unsubscribed so
+**      a subscribe failure leaves the current subscriptions in place.
+**   2. An unsubscribe failure is reported but doesn't fail the reload since
+**      messages on the old MID are rejected as invalid.
+**   3. A current MID that's reused by the new configuration isn't
+**      unsubscribed.
+*/
+static int32 ReloadSubscriptions(CFE_SB_MsgId_t NewCmdMid, CFE_SB_MsgId_t NewExecuteMid)
+{
+
+   int32 SysStatus = CFE_SUCCESS;
+   int32 UnsubStatus;
+   bool  CmdMidChanged     = !CFE_SB_MsgId_Equal(NewCmdMid, PlSim.CmdMid);
+   bool  ExecuteMidChanged = !CFE_SB_MsgId_Equal(NewExecuteMid, PlSim.ExecuteMid);
+   
+   if (CmdMidChanged)
+   {
+      SysStatus = CFE_SB_Subscribe(NewCmdMid, PlSim.CmdPipe);
+   }
+   if (SysStatus == CFE_SUCCESS && ExecuteMidChanged)
+   {
+      SysStatus = CFE_SB_Subscribe(NewExecuteMid, PlSim.CmdPipe);
+      if (SysStatus != CFE_SUCCESS && CmdMidChanged)
+      {
+         CFE_SB_Unsubscribe(NewCmdMid, PlSim.CmdPipe);
+      }
+   }
+   
+   if (SysStatus == CFE_SUCCESS)
+   {
+      
+      if (CmdMidChanged && !CFE_SB_MsgId_Equal(PlSim.CmdMid, NewExecuteMid))
+      {
+         UnsubStatus = CFE_SB_Unsubscribe(PlSim.CmdMid, PlSim.CmdPipe);
+         if (UnsubStatus != CFE_SUCCESS)
+         {
+            CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Failed to unsubscribe from previous command MID 0x%04X, status = 0x%08X",
+                              (unsigned int)CFE_SB_MsgIdToValue(PlSim.CmdMid), (unsigned int)UnsubStatus);
+         }
+      }
+      if (ExecuteMidChanged && !CFE_SB_MsgId_Equal(PlSim.ExecuteMid, NewCmdMid))
+      {
+         UnsubStatus = CFE_SB_Unsubscribe(PlSim.ExecuteMid, PlSim.CmdPipe);
+         if (UnsubStatus != CFE_SUCCESS)
+         {
+            CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Failed to unsubscribe from previous execute MID 0x%04X, status = 0x%08X",
+                              (unsigned int)CFE_SB_MsgIdToValue(PlSim.ExecuteMid), (unsigned int)UnsubStatus);
+         }
+      }
+      
+   } /* End if subscribed */
+   else
+   {
+      CFE_EVS_SendEvent(PL_SIM_CMD_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to subscribe to new %s MID, status = 0x%08X",
+                        (CmdMidChanged && !ExecuteMidChanged) ? "command" : "command or execute",
+                        (unsigned int)SysStatus);
+   }
+   
+   return SysStatus;
+   
+} /* End ReloadSubscriptions() */
+
+
 /******************************************************************************
 ** Function: SendStatusTlm
 **
@@ -423,9 +1081,57 @@ static void SendStatusTlm(void)
    Payload->LibDetectorReadoutRow    = PlSim.Lib.Detector.ReadoutRow;
    Payload->LibDetectorImageCnt      = PlSim.Lib.Detector.ImageCnt;
 
+   /*
+   ** Telemetry Shaper Data
+   */
+   
+   Payload->StatusBacklogCnt      = PlSim.TlmShaper.OutputClass[TLM_SHAPER_STATUS].BacklogCnt;
+   Payload->StatusThrottledBytes  = PlSim.TlmShaper.OutputClass[TLM_SHAPER_STATUS].ThrottledBytes;
+   Payload->StatusDroppedPkts     = PlSim.TlmShaper.OutputClass[TLM_SHAPER_STATUS].DroppedPkts;
+   Payload->ScienceBacklogCnt     = PlSim.TlmShaper.OutputClass[TLM_SHAPER_SCIENCE].BacklogCnt;
+   Payload->ScienceThrottledBytes = PlSim.TlmShaper.OutputClass[TLM_SHAPER_SCIENCE].ThrottledBytes;
+   Payload->ScienceDroppedPkts    = PlSim.TlmShaper.OutputClass[TLM_SHAPER_SCIENCE].DroppedPkts;
+
 
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(PlSim.StatusTlm.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(PlSim.StatusTlm.TelemetryHeader), true);
+   TLM_SHAPER_Transmit(TLM_SHAPER_STATUS, CFE_MSG_PTR(PlSim.StatusTlm.TelemetryHeader));
 
 } /* End SendStatusTlm() */
 
+
+/******************************************************************************
+** Function: ValidateConfig
+**
+** Check the parameters that would leave the app unable to run before the
+** configuration is used.
+*/
+static bool ValidateConfig(const PL_SIM_Config_t *Config)
+{
+
+   bool RetStatus = false;
+   
+   if (Config->CFG_CMD_PIPE_DEPTH.Int == 0 || Config->CFG_CMD_PIPE_DEPTH.Int > PL_SIM_CMD_PIPE_DEPTH_MAX)
+   {
+      CFE_EVS_SendEvent(PL_SIM_CONFIG_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid CMD_PIPE_DEPTH %d, must be between 1 and %d",
+                        (int)Config->CFG_CMD_PIPE_DEPTH.Int, PL_SIM_CMD_PIPE_DEPTH_MAX);
+   }
+   else if (Config->CFG_CMD_PIPE_NAME.Str[0] == '\0')
+   {
+      CFE_EVS_SendEvent(PL_SIM_CONFIG_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid CMD_PIPE_NAME, the name is empty");
+   }
+   else if (Config->CFG_EVT_LOG_FLUSH_LIM.Int == 0)
+   {
+      CFE_EVS_SendEvent(PL_SIM_CONFIG_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid EVT_LOG_FLUSH_LIM 0, must be greater than 0");
+   }
+   else
+   {
+      RetStatus = true;
+   }
+   
+   return RetStatus;
+
+} /* End ValidateConfig() */
+
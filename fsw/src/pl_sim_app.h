@@ -18,6 +18,14 @@
 **  Notes:
 **    1. PL_SIM does not use performance monitor IDs because simulator apps
 **       are not part of a flight build.
+**    2. Command and execution cycle events are written to the deferred
+**       event log (EVT_LOG) and sent to EVS at the end of each execution
+**       cycle. Initialization and exit events are sent directly to EVS.
+**    3. The JSON init file is parsed into PL_SIM_Config_t which is cached
+**       in a binary file (CFG_CACHE). The cache is loaded on subsequent
+**       starts until the JSON file changes. Configuration values must be
+**       read from PlSim.Config because IniTbl isn't constructed when the
+**       cache is used.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide.
@@ -33,6 +41,11 @@
 
 #include "app_cfg.h"
 #include "pl_sim_lib.h"
+#include "evt_log.h"
+#include "load_gen.h"
+#include "tlm_shaper.h"
+#include "cfg_cache.h"
+#include "img_stats.h"
 
 
 /***********************/
@@ -54,6 +67,11 @@
 #define PL_SIM_PWR_RESET_CMD_EID     (PL_SIM_BASE_EID +  8)
 #define PL_SIM_SET_FAULT_CMD_EID     (PL_SIM_BASE_EID +  9)
 #define PL_SIM_CLEAR_FAULT_CMD_EID   (PL_SIM_BASE_EID + 10)
+#define PL_SIM_RELOAD_CFG_CMD_EID    (PL_SIM_BASE_EID + 11)
+#define PL_SIM_RELOAD_CFG_EID        (PL_SIM_BASE_EID + 12)
+#define PL_SIM_RELOAD_CFG_ERR_EID    (PL_SIM_BASE_EID + 13)
+#define PL_SIM_CONFIG_ERR_EID        (PL_SIM_BASE_EID + 14)
+#define PL_SIM_CMD_PIPE_ERR_EID      (PL_SIM_BASE_EID + 15)
 
 
 /**********************/
@@ -73,6 +91,35 @@
 */
 
 
+/******************************************************************************
+** PL_SIM_Config
+**
+** Parsed JSON init file configuration generated from APP_CONFIG in app_cfg.h.
+** Each parameter is a member with the parameter's name so it's accessed
+** using its CFG_ macro and the member for its APP_CONFIG type, for example
+** PlSim.Config.CFG_CMD_PIPE_DEPTH.Int or PlSim.Config.CFG_CMD_PIPE_NAME.Str.
+*/
+
+#define PL_SIM_CFG_STR_TYPE  "char*"  /* APP_CONFIG string type, all others are integers */
+
+typedef union
+{
+
+   uint32  Int;
+   char    Str[OS_MAX_API_NAME];
+
+} PL_SIM_CfgParam_t;
+
+#define PL_SIM_CFG_PARAM(Name, Type)  PL_SIM_CfgParam_t Name;
+
+typedef struct
+{
+
+   APP_CONFIG(PL_SIM_CFG_PARAM)
+
+} PL_SIM_Config_t;
+
+
 /******************************************************************************
 ** PL_SIM_Class
 */
@@ -84,9 +131,19 @@ typedef struct
    */ 
    
    INITBL_Class_t  IniTbl; 
+   PL_SIM_Config_t Config;
    CFE_SB_PipeId_t CmdPipe;
    CMDMGR_Class_t  CmdMgr;
    
+   /*
+   ** App Objects
+   */
+   
+   EVT_LOG_Class_t     EvtLog;
+   LOAD_GEN_Class_t    LoadGen;
+   TLM_SHAPER_Class_t  TlmShaper;
+   IMG_STATS_Class_t   ImgStats;
+   
    /*
    ** Telemetry Packets
    */
@@ -102,6 +159,7 @@ typedef struct
    CFE_SB_MsgId_t ExecuteMid;
    uint32         TlmSlowRate;
    uint32         TlmSlowRateCnt;
+   bool           ReloadCfgPending;
    
    PL_SIM_LIB_Class_t  Lib;
    
@@ -135,22 +193,36 @@ bool PL_SIM_NoOpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
 /******************************************************************************
-** Functions: PL_SIM_PowerOnCmd, PL_SIM_PowerOffCmd, PL_SIM_PowerResetCmd
+** Functions: PL_SIM_PowerOnCmd, PL_SIM_PowerOffCmd
 **
-** Power on/off/reset payload.
+** Power on/off payload.
 **
 ** Notes:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
 **  2. Use separate command function codes & functions as opposed to one 
 **     command with a parameter that would need validation
-**  3. Reset allows an intermediate level of initialization to be simulated
-**     that allows some system state to persist across the reset. For
-**     science data may be allowed to resume immediately after a reset.
 **
 */
 bool PL_SIM_PowerOnCmd (void* DataObjPtr,   const CFE_MSG_Message_t *MsgPtr);
 bool PL_SIM_PowerOffCmd(void* DataObjPtr,   const CFE_MSG_Message_t *MsgPtr);
-bool PL_SIM_PowerResetCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: PL_SIM_ReloadCfgCmd
+**
+** Reload the JSON init file and apply configuration changes at the start of
+** the next execution cycle.
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. The PL_SIM library state is not modified.
+**  3. If the command pipe depth or name changes the pipe is deleted and
+**     recreated so messages queued behind the execution cycle message are
+**     lost.
+**  4. APP_CFE_NAME changes require an app restart.
+**
+*/
+bool PL_SIM_ReloadCfgCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
 /******************************************************************************
@@ -0,0 +1,252 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the telemetry output bandwidth shaper
+**
+**  Notes:
+**    1. See header notes.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "tlm_shaper.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void SendBacklog(TLM_SHAPER_OutputClass_t *OutputClass);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static TLM_SHAPER_Class_t *TlmShaper = NULL;
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Constructor
+**
+*/
+void TLM_SHAPER_Constructor(TLM_SHAPER_Class_t *TlmShaperPtr)
+{
+
+   TlmShaper = TlmShaperPtr;
+
+   CFE_PSP_MemSet((void*)TlmShaper, 0, sizeof(TLM_SHAPER_Class_t));
+
+} /* End TLM_SHAPER_Constructor() */
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Execute
+**
+*/
+void TLM_SHAPER_Execute(void)
+{
+
+   uint16 i;
+   TLM_SHAPER_OutputClass_t *OutputClass;
+
+   for (i=0; i < TLM_SHAPER_CLASS_CNT; i++)
+   {
+
+      OutputClass = &TlmShaper->OutputClass[i];
+
+      if (OutputClass->BytesPerSec > 0)
+      {
+
+         OutputClass->Tokens += OutputClass->BytesPerSec;
+         if (OutputClass->Tokens > OutputClass->BurstBytes)
+         {
+            OutputClass->Tokens = OutputClass->BurstBytes;
+         }
+
+      }
+
+      SendBacklog(OutputClass);
+
+   } /* End class loop */
+
+} /* End TLM_SHAPER_Execute() */
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_ResetStatus
+**
+*/
+void TLM_SHAPER_ResetStatus(void)
+{
+
+   uint16 i;
+
+   for (i=0; i < TLM_SHAPER_CLASS_CNT; i++)
+   {
+      TlmShaper->OutputClass[i].ThrottledBytes = 0;
+      TlmShaper->OutputClass[i].DroppedPkts    = 0;
+   }
+
+} /* End TLM_SHAPER_ResetStatus() */
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_SetRate
+**
+** Notes:
+**   1. If shaping is disabled the backlog is sent on the next execution
+**      cycle or ahead of the next packet transmitted on the class,
+**      whichever comes first.
+**   2. A burst smaller than the largest backlog packet would drop packets
+**      that a larger bucket could send so it's raised rather than rejected.
+*/
+void TLM_SHAPER_SetRate(uint16 OutputClass, uint32 BytesPerSec, uint32 BurstBytes)
+{
+
+   if (OutputClass < TLM_SHAPER_CLASS_CNT)
+   {
+
+      if (BytesPerSec > 0 && BurstBytes < TLM_SHAPER_PKT_LEN_MAX)
+      {
+         CFE_EVS_SendEvent(TLM_SHAPER_SET_RATE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Telemetry shaper class %d burst of %d bytes raised to the maximum packet length %d",
+                           OutputClass, (int)BurstBytes, TLM_SHAPER_PKT_LEN_MAX);
+         BurstBytes = TLM_SHAPER_PKT_LEN_MAX;
+      }
+
+      TlmShaper->OutputClass[OutputClass].BytesPerSec = BytesPerSec;
+      TlmShaper->OutputClass[OutputClass].BurstBytes  = BurstBytes;
+      TlmShaper->OutputClass[OutputClass].Tokens      = BurstBytes;
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent(TLM_SHAPER_SET_RATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Telemetry shaper set rate rejected, invalid output class %d (max %d)",
+                        OutputClass, TLM_SHAPER_CLASS_CNT - 1);
+   }
+
+} /* End TLM_SHAPER_SetRate() */
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Transmit
+**
+** Notes:
+**   1. When shaping is disabled any backlog is sent before the new packet
+**      so packets leave a class in the order they were transmitted.
+*/
+void TLM_SHAPER_Transmit(uint16 OutputClass, CFE_MSG_Message_t *MsgPtr)
+{
+
+   TLM_SHAPER_OutputClass_t *Class;
+   TLM_SHAPER_BacklogPkt_t  *BacklogPkt;
+   CFE_MSG_Size_t MsgSize = 0;
+
+   if (OutputClass >= TLM_SHAPER_CLASS_CNT)
+   {
+      CFE_EVS_SendEvent(TLM_SHAPER_TRANSMIT_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Telemetry shaper transmit rejected, invalid output class %d (max %d)",
+                        OutputClass, TLM_SHAPER_CLASS_CNT - 1);
+      return;
+   }
+
+   Class = &TlmShaper->OutputClass[OutputClass];
+
+   CFE_MSG_GetSize(MsgPtr, &MsgSize);
+
+   if (Class->BytesPerSec == 0)
+   {
+
+      /* Shaping may have been disabled with packets still queued */
+      SendBacklog(Class);
+      CFE_SB_TransmitMsg(MsgPtr, true);
+
+   }
+   else if (Class->BacklogCnt == 0 && MsgSize <= Class->Tokens)
+   {
+
+      Class->Tokens -= MsgSize;
+      CFE_SB_TransmitMsg(MsgPtr, true);
+
+   }
+   else if (Class->BacklogCnt < TLM_SHAPER_BACKLOG_PKT_MAX &&
+            MsgSize <= TLM_SHAPER_PKT_LEN_MAX && MsgSize <= Class->BurstBytes)
+   {
+
+      BacklogPkt = &Class->Backlog[(Class->BacklogHead + Class->BacklogCnt) % TLM_SHAPER_BACKLOG_PKT_MAX];
+
+      memcpy(BacklogPkt->Pkt.Byte, MsgPtr, MsgSize);
+      BacklogPkt->Len = MsgSize;
+
+      Class->BacklogCnt++;
+      Class->ThrottledBytes += MsgSize;
+
+   }
+   else
+   {
+
+      Class->DroppedPkts++;
+
+   }
+
+} /* End TLM_SHAPER_Transmit() */
+
+
+/******************************************************************************
+** Function: SendBacklog
+**
+** Send backlog packets in order while the class has tokens for them.
+**
+** Notes:
+**   1. The entire backlog is sent when shaping is disabled for the class.
+*/
+static void SendBacklog(TLM_SHAPER_OutputClass_t *OutputClass)
+{
+
+   TLM_SHAPER_BacklogPkt_t *BacklogPkt;
+
+   while (OutputClass->BacklogCnt > 0)
+   {
+
+      BacklogPkt = &OutputClass->Backlog[OutputClass->BacklogHead];
+
+      if (OutputClass->BytesPerSec > 0)
+      {
+         if (BacklogPkt->Len > OutputClass->Tokens)
+         {
+            break;
+         }
+         OutputClass->Tokens -= BacklogPkt->Len;
+      }
+
+      CFE_SB_TransmitMsg(&BacklogPkt->Pkt.Msg, true);
+
+      OutputClass->BacklogHead = (OutputClass->BacklogHead + 1) % TLM_SHAPER_BACKLOG_PKT_MAX;
+      OutputClass->BacklogCnt--;
+
+   } /* End backlog loop */
+
+} /* End SendBacklog() */
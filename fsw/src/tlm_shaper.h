@@ -0,0 +1,197 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the telemetry output bandwidth shaper
+**
+**  Notes:
+**    1. Simulates an instrument behind a rate limited interface. Every
+**       packet the app sends is passed through TLM_SHAPER_Transmit() with
+**       an output class. Each class has a token bucket that's refilled
+**       with BytesPerSec tokens each execution cycle up to BurstBytes.
+**    2. A packet is sent immediately if its class backlog is empty and
+**       there are enough tokens. Otherwise it's copied to the class backlog
+**       queue and sent by TLM_SHAPER_Execute() when tokens are available.
+**       Packets are dropped when the backlog is full or the packet can
+**       never be sent because it's larger than BurstBytes.
+**    3. A BytesPerSec value of zero disables shaping for a class so
+**       packets are always sent immediately. Any backlog left from when the
+**       class was shaped is sent first so packet order is preserved.
+**    4. BurstBytes is raised to TLM_SHAPER_PKT_LEN_MAX for a shaped class
+**       so every packet that fits in the backlog can eventually be sent.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+#ifndef _tlm_shaper_
+#define _tlm_shaper_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define TLM_SHAPER_SET_RATE_EID      (TLM_SHAPER_BASE_EID + 0)
+#define TLM_SHAPER_SET_RATE_ERR_EID  (TLM_SHAPER_BASE_EID + 1)
+#define TLM_SHAPER_TRANSMIT_ERR_EID  (TLM_SHAPER_BASE_EID + 2)
+
+
+/*
+** Output classes
+*/
+
+#define TLM_SHAPER_STATUS     0
+#define TLM_SHAPER_SCIENCE    1
+#define TLM_SHAPER_CLASS_CNT  2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Backlog packet
+*/
+
+typedef struct
+{
+
+   size_t  Len;
+   union
+   {
+      CFE_MSG_Message_t  Msg;
+      uint8              Byte[TLM_SHAPER_PKT_LEN_MAX];
+   } Pkt;
+
+} TLM_SHAPER_BacklogPkt_t;
+
+
+/******************************************************************************
+** Output class
+*/
+
+typedef struct
+{
+
+   uint32  BytesPerSec;
+   uint32  BurstBytes;
+   uint32  Tokens;
+
+   uint16  BacklogHead;
+   uint16  BacklogCnt;
+   uint32  ThrottledBytes;
+   uint32  DroppedPkts;
+
+   TLM_SHAPER_BacklogPkt_t Backlog[TLM_SHAPER_BACKLOG_PKT_MAX];
+
+} TLM_SHAPER_OutputClass_t;
+
+
+/******************************************************************************
+** Class definition
+*/
+
+typedef struct
+{
+
+   TLM_SHAPER_OutputClass_t OutputClass[TLM_SHAPER_CLASS_CNT];
+
+} TLM_SHAPER_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Constructor
+**
+** Initialize the telemetry shaper to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. Shaping is disabled for all classes until TLM_SHAPER_SetRate() is
+**      called.
+**
+*/
+void TLM_SHAPER_Constructor(TLM_SHAPER_Class_t *TlmShaperPtr);
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Execute
+**
+** Refill each class's token bucket and send backlog packets.
+**
+** Notes:
+**  1. Must be called once per second before any packets are transmitted
+**     in the execution cycle so backlog packets are sent in order.
+**
+*/
+void TLM_SHAPER_Execute(void);
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_ResetStatus
+**
+** Reset counters without changing backlog queues or token buckets.
+**
+*/
+void TLM_SHAPER_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_SetRate
+**
+** Define the rate and burst size for an output class. The token bucket is
+** filled and the backlog is left intact.
+**
+** Notes:
+**  1. An invalid output class is rejected and a BurstBytes value below
+**     TLM_SHAPER_PKT_LEN_MAX is raised to it when shaping is enabled. An
+**     event is sent in both cases.
+**
+*/
+void TLM_SHAPER_SetRate(uint16 OutputClass, uint32 BytesPerSec, uint32 BurstBytes);
+
+
+/******************************************************************************
+** Function: TLM_SHAPER_Transmit
+**
+** Send a packet or add it to the output class's backlog.
+**
+** Notes:
+**  1. The packet should be timestamped before calling this function so
+**     backlog packets retain their creation time.
+**  2. A packet with an invalid output class is not sent and an event is
+**     sent.
+**
+*/
+void TLM_SHAPER_Transmit(uint16 OutputClass, CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _tlm_shaper_ */